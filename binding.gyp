@@ -16,8 +16,15 @@
 				"src/utils/typed_array.cpp",
 				"src/utils/string_list.cpp",
 				"src/utils/number_list.cpp",
+				"src/utils/rasterio_window.cpp",
+				"src/utils/layer_columns.cpp",
+				"src/utils/geojson.cpp",
+				"src/utils/coordinates.cpp",
+				"src/utils/field_names.cpp",
 				"src/utils/warp_options.cpp",
 				"src/utils/ptr_manager.cpp",
+				"src/utils/pinned_block.cpp",
+				"src/utils/dataset_pool.cpp",
 				"src/node_gdal.cpp",
 				"src/gdal_common.cpp",
 				"src/gdal_dataset.cpp",
@@ -42,8 +49,10 @@
 				"src/gdal_warper.cpp",
 				"src/gdal_algorithms.cpp",
 				"src/gdal_memfile.cpp",
+				"src/gdal_vsijs.cpp",
 				"src/collections/dataset_bands.cpp",
 				"src/collections/dataset_layers.cpp",
+				"src/collections/dataset_pixels.cpp",
 				"src/collections/layer_features.cpp",
 				"src/collections/layer_fields.cpp",
 				"src/collections/feature_fields.cpp",
@@ -55,7 +64,9 @@
 				"src/collections/rasterband_pixels.cpp",
 				"src/collections/gdal_drivers.cpp",
 				"src/async/async_rasterio.cpp",
-				"src/async/async_open.cpp"
+				"src/async/async_open.cpp",
+				"src/async/thread_pool.cpp",
+				"src/async/async_progress.cpp"
 			],
 			"include_dirs": [
 				"<!(node -e \"require('nan')\")"
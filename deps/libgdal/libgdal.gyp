@@ -215,6 +215,12 @@
 							"-lodbccp32.lib"
 						]
 					}
+				}],
+				["OS == 'linux'", {
+					"defines": [
+						"HAVE_MMAP",
+						"HAVE_5ARGS_MREMAP"
+					]
 				}]
 			],
 			"direct_dependent_settings": {
@@ -234,17 +234,6 @@ gdal.FeatureFields.prototype.toJSON = function () {
   return JSON.stringify(this.toObject())
 }
 
-/**
- * Converts the geometry to a GeoJSON object representation.
- *
- * @for gdal.Geometry
- * @method toObject
- * @return {Object} GeoJSON
- */
-gdal.Geometry.prototype.toObject = function () {
-  return JSON.parse(this.toJSON())
-}
-
 /**
  * Iterates through all field definitions using a callback function.
  *
@@ -521,7 +510,11 @@ gdal.PolygonRings.prototype.toArray = defaultToArray
  * @static
  * @param {String|Buffer} path Path to dataset or in-memory Buffer to open
  * @param {String} [mode="r"] The mode to use to open the file: `"r"`, `"r+"`, or `"w"`
- * @param {String|Array} [drivers] Driver name, or list of driver names to attempt to use.
+ * @param {String|Array|Object} [drivers] Driver name, or list of driver names to attempt to use.
+ * Can also be an options object when opening an existing dataset without specifying the drivers.
+ * @param {Integer} [drivers.pool] Keep up to `pool` independent read-only handles on the file,
+ * allowing asynchronous reads of raster data to run in parallel instead of one after another.
+ * Only supported with the `"r"` mode.
  *
  * @param {Integer} [x_size] Used when creating a raster dataset with the `"w"` mode.
  * @param {Integer} [y_size] Used when creating a raster dataset with the `"w"` mode.
@@ -531,6 +524,11 @@ gdal.PolygonRings.prototype.toArray = defaultToArray
  *
  * @return {gdal.Dataset}
  */
+// gdal.open() accepts an options object in place of the drivers list
+function isOpenOptions(drivers) {
+  return typeof drivers === 'object' && drivers !== null && !Array.isArray(drivers)
+}
+
 gdal.open = (function () {
   const open = gdal.open
 
@@ -548,6 +546,10 @@ gdal.open = (function () {
       return ds
     }
 
+    if (isOpenOptions(drivers)) {
+      return open.call(gdal, filename, mode, drivers)
+    }
+
     if (typeof drivers === 'string') {
       drivers = [ drivers ]
     } else if (drivers && !Array.isArray(drivers)) {
@@ -608,6 +610,219 @@ gdal.open = (function () {
 const promisify = require('util').promisify
 const callbackify = require('util').callbackify
 
+// Wraps a native async method that expects its callback at position cb_arg
+// so that the callback can be omitted (a Promise is returned instead) or
+// passed as the last argument even if some optional arguments are omitted
+function promisifiable(method, cb_arg) {
+  const methodPromise = promisify(method)
+  return function () {
+    const args = Array.prototype.slice.call(arguments, 0, cb_arg + 1)
+    let callback
+    if (typeof args[args.length - 1] === 'function') callback = args.pop()
+    while (args.length < cb_arg) args.push(undefined)
+    if (callback) {
+      args.push(callback)
+      return method.apply(this, args)
+    }
+    return methodPromise.apply(this, args)
+  }
+}
+
+/**
+ * Options of the long-running asynchronous operations
+ * @typedef {object} JobOptions
+ * @property {Function} [progress_cb] called with the completion ratio (0 to 1), not more than once per event
+ * loop iteration
+ * @property {AbortSignal} [signal] aborts the operation, which then fails with an error
+ */
+
+// Runs a native async method that expects a progress callback and an abort
+// flag (an Int32Array that is set when the signal aborts) before its callback
+// Returns a Promise if no callback is given
+function runJob(method, self, args, job_options, callback) {
+  const job = job_options || {}
+  let flag, onAbort
+  if (job.signal) {
+    flag = new Int32Array(1)
+    if (job.signal.aborted) {
+      flag[0] = 1
+    } else {
+      onAbort = () => {
+        flag[0] = 1
+      }
+      job.signal.addEventListener('abort', onAbort)
+    }
+  }
+  const done = () => {
+    if (onAbort) job.signal.removeEventListener('abort', onAbort)
+  }
+  const run = (cb) => {
+    try {
+      return method.apply(self, args.concat([ job.progress_cb, flag, (e, r) => {
+        done()
+        cb(e, r)
+      } ]))
+    } catch (e) {
+      done()
+      throw e
+    }
+  }
+  if (callback) return run(callback)
+  return new Promise((resolve, reject) => run((e, r) => (e ? reject(e) : resolve(r))))
+}
+
+gdal.LayerFeatures.prototype.getAsync = promisifiable(gdal.LayerFeatures.prototype.getAsync, 1)
+gdal.LayerFeatures.prototype.firstAsync = promisifiable(gdal.LayerFeatures.prototype.firstAsync, 0)
+gdal.LayerFeatures.prototype.nextAsync = promisifiable(gdal.LayerFeatures.prototype.nextAsync, 0)
+gdal.LayerFeatures.prototype.countAsync = promisifiable(gdal.LayerFeatures.prototype.countAsync, 1)
+gdal.LayerFeatures.prototype.readBatchAsync = promisifiable(gdal.LayerFeatures.prototype.readBatchAsync, 1)
+
+// Methods taking a single options object which also holds the job options
+function optionsJobAsync(method) {
+  return function (options, callback) {
+    return runJob(method, gdal, [ options ], options, callback)
+  }
+}
+
+gdal.fillNodataAsync = optionsJobAsync(gdal.fillNodataAsync)
+gdal.contourGenerateAsync = optionsJobAsync(gdal.contourGenerateAsync)
+gdal.sieveFilterAsync = optionsJobAsync(gdal.sieveFilterAsync)
+gdal.polygonizeAsync = optionsJobAsync(gdal.polygonizeAsync)
+gdal.checksumImageAsync = promisifiable(gdal.checksumImageAsync, 5)
+gdal.reprojectImageAsync = optionsJobAsync(gdal.reprojectImageAsync)
+gdal.RasterBand.prototype.getStatisticsAsync = promisifiable(gdal.RasterBand.prototype.getStatisticsAsync, 2)
+gdal.Dataset.prototype.executeSQLAsync = promisifiable(gdal.Dataset.prototype.executeSQLAsync, 3)
+
+gdal.RasterBand.prototype.computeStatisticsAsync = (function () {
+  const computeStatistics = gdal.RasterBand.prototype.computeStatisticsAsync
+  return function (allow_approximation, options, cb) {
+    if (typeof arguments[arguments.length - 1] === 'function' && cb === undefined) {
+      cb = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    return runJob(computeStatistics, this, [ allow_approximation ], options, cb)
+  }
+})()
+
+gdal.Dataset.prototype.buildOverviewsAsync = (function () {
+  const buildOverviews = gdal.Dataset.prototype.buildOverviewsAsync
+  return function (resampling, overviews, bands, options, cb) {
+    if (typeof arguments[arguments.length - 1] === 'function' && cb === undefined) {
+      cb = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    return runJob(buildOverviews, this, [ resampling, overviews, bands, options ], options, cb)
+  }
+})()
+
+// Number of features fetched by each background read of the async iterator
+const featureReadAhead = 256
+
+/**
+ * Asynchronously iterates through all features, to be used with `for await`.
+ *
+ * Features are read in batches in the background: while the current batch
+ * is being consumed, the next one is already being read.
+ * The iterator resets the feature pointer when it starts.
+ *
+ * @example
+ * ```
+ * for await (const feature of layer.features) { ... }```
+ *
+ * @for gdal.LayerFeatures
+ * @method Symbol.asyncIterator
+ * @return {AsyncIterator<gdal.Feature>}
+ */
+gdal.LayerFeatures.prototype[Symbol.asyncIterator] = function () {
+  const features = this
+  let buffer = []
+  let pos = 0
+  let done = false
+  // a failed read is reported by the next step(), not as an unhandled rejection
+  const prefetch = (promise) => {
+    promise.catch(() => undefined)
+    return promise
+  }
+  let pending = prefetch(features.firstAsync().then((feature) => (feature ? [ feature ] : [])))
+  let queue = Promise.resolve()
+
+  const step = () => {
+    if (pos < buffer.length) return { value: buffer[pos++], done: false }
+    if (done) return { value: undefined, done: true }
+    return pending.then(
+      (batch) => {
+        if (done || !batch.length) {
+          done = true
+          return { value: undefined, done: true }
+        }
+        buffer = batch
+        pos = 0
+        pending = prefetch(features.readBatchAsync(featureReadAhead))
+        return { value: buffer[pos++], done: false }
+      },
+      (err) => {
+        done = true
+        throw err
+      }
+    )
+  }
+
+  return {
+    next: () => {
+      queue = queue.then(step)
+      return queue
+    },
+    return: (value) => {
+      done = true
+      buffer = []
+      return Promise.resolve({ value, done: true })
+    },
+    [Symbol.asyncIterator]: function () {
+      return this
+    }
+  }
+}
+
+gdal.Layer.prototype.readColumns = (function () {
+  const readColumns = gdal.Layer.prototype.readColumns
+  return function (options) {
+    if (!options) options = {}
+    return readColumns.call(this, options.fields, options.geometry, options.batchSize)
+  }
+})()
+
+gdal.Layer.prototype.readColumnsAsync = (function () {
+  const readColumns = gdal.Layer.prototype.readColumnsAsync
+  return function (options, cb) {
+    if (typeof arguments[arguments.length - 1] === 'function' && cb === undefined) {
+      cb = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    if (!options) options = {}
+    return runJob(readColumns, this, [ options.fields, options.geometry, options.batchSize ], options, cb)
+  }
+})()
+
+gdal.Layer.prototype.toGeoJSONString = (function () {
+  const toGeoJSONString = gdal.Layer.prototype.toGeoJSONString
+  return function (options) {
+    if (!options) options = {}
+    return toGeoJSONString.call(this, options.precision, options.bbox)
+  }
+})()
+
+gdal.Layer.prototype.toGeoJSONStringAsync = (function () {
+  const toGeoJSONString = gdal.Layer.prototype.toGeoJSONStringAsync
+  return function (options, cb) {
+    if (typeof arguments[arguments.length - 1] === 'function' && cb === undefined) {
+      cb = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    if (!options) options = {}
+    return runJob(toGeoJSONString, this, [ options.precision, options.bbox ], options, cb)
+  }
+})()
+
 gdal.Driver.prototype.createAsync = (function () {
   const driverCreateCb = gdal.Driver.prototype.createAsync
   const driverCreatePromise = promisify(gdal.Driver.prototype.createAsync)
@@ -634,22 +849,30 @@ gdal.Driver.prototype.createAsync = (function () {
 })()
 
 gdal.Driver.prototype.createCopyAsync = (function () {
-  const driverCreateCopyCb = gdal.Driver.prototype.createCopyAsync
-  const driverCreateCopyPromise = promisify(gdal.Driver.prototype.createCopyAsync)
+  const driverCreateCopy = gdal.Driver.prototype.createCopyAsync
   return function (
     filename,
     src,
     options,
+    job_options,
     callback
   ) {
     if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
       callback = arguments[arguments.length - 1]
       arguments[arguments.length - 1] = undefined
     }
-    if (callback) {
-      return driverCreateCopyCb.call(this, filename, src, options, callback)
+    return runJob(driverCreateCopy, this, [ filename, src, options ], job_options, callback)
+  }
+})()
+
+gdal.Driver.prototype.createCopyToBufferAsync = (function () {
+  const createCopyToBuffer = gdal.Driver.prototype.createCopyToBufferAsync
+  return function (src, options, job_options, callback) {
+    if (typeof arguments[arguments.length - 1] === 'function' && callback === undefined) {
+      callback = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
     }
-    return driverCreateCopyPromise.call(this, filename, src, options)
+    return runJob(createCopyToBuffer, this, [ src, options ], job_options, callback)
   }
 })()
 
@@ -693,7 +916,11 @@ gdal.Driver.prototype.openAsync = (function () {
  * @static
  * @param {String|Buffer} path Path to dataset or in-memory Buffer to open
  * @param {String} [mode="r"] The mode to use to open the file: `"r"`, `"r+"`, or `"w"`
- * @param {String|Array} [drivers] Driver name, or list of driver names to attempt to use.
+ * @param {String|Array|Object} [drivers] Driver name, or list of driver names to attempt to use.
+ * Can also be an options object when opening an existing dataset without specifying the drivers.
+ * @param {Integer} [drivers.pool] Keep up to `pool` independent read-only handles on the file,
+ * allowing asynchronous reads of raster data to run in parallel instead of one after another.
+ * Only supported with the `"r"` mode.
  *
  * @param {Integer} [x_size] Used when creating a raster dataset with the `"w"` mode.
  * @param {Integer} [y_size] Used when creating a raster dataset with the `"w"` mode.
@@ -733,6 +960,9 @@ gdal.openAsync = (function () {
           return ds
         })
       }
+      if (isOpenOptions(drivers)) {
+        return openPromise.call(gdal, filename, mode, drivers)
+      }
       if (typeof drivers === 'string') {
         drivers = [ drivers ]
       } else if (drivers && !Array.isArray(drivers)) {
@@ -774,7 +1004,7 @@ gdal.openAsync = (function () {
       }
 
       // call gdal.open() method normally
-      return openPromise.call(gdal, filename, mode)
+      return openPromise.call(gdal, filename, mode, undefined)
     }
   })()
 
@@ -884,23 +1114,10 @@ gdal.DatasetLayers.prototype.create = (function () {
   }
 })()
 
-function getTypedArrayType(array) {
-  if (array instanceof Uint8Array) return 1 // gdal.GDT_Byte
-  if (array instanceof Int8Array) return 1 // gdal.GDT_Byte
-  if (array instanceof Int16Array) return 3 // gdal.GDT_Int16
-  if (array instanceof Uint16Array) return 2 // gdal.GDT_UInt16
-  if (array instanceof Int32Array) return 5 // gdal.GDT_Int32
-  if (array instanceof Uint32Array) return 4 // gdal.GDT_UInt32
-  if (array instanceof Float32Array) return 6 // gdal.GDT_Float32
-  if (array instanceof Float64Array) return 7 // gdal.GDT_Float64
-  return 0 // gdal.GDT_Unknown
-}
-
 gdal.RasterBandPixels.prototype.read = (function () {
   const read = gdal.RasterBandPixels.prototype.read
   return function (x, y, width, height, data, options) {
     if (!options) options = {}
-    if (data) data._gdal_type = getTypedArrayType(data)
     return read.apply(this, [
       x,
       y,
@@ -911,14 +1128,14 @@ gdal.RasterBandPixels.prototype.read = (function () {
       options.buffer_height,
       options.type,
       options.pixel_space,
-      options.line_space
+      options.line_space,
+      options.resampling
     ])
   }
 })()
 
 gdal.RasterBandPixels.prototype.readAsync = (function () {
-  const readCb = gdal.RasterBandPixels.prototype.readAsync
-  const readPromise = promisify(gdal.RasterBandPixels.prototype.readAsync)
+  const read = gdal.RasterBandPixels.prototype.readAsync
   return function (x, y, width, height, data, options, cb) {
     if (typeof arguments[arguments.length - 1] === 'function' && cb === undefined) {
       cb = arguments[arguments.length - 1]
@@ -926,23 +1143,7 @@ gdal.RasterBandPixels.prototype.readAsync = (function () {
       arguments[arguments.length - 1] = undefined
     }
     if (!options) options = {}
-    if (data) data._gdal_type = getTypedArrayType(data)
-    if (cb) {
-      return readCb.apply(this, [
-        x,
-        y,
-        width,
-        height,
-        data,
-        options.buffer_width,
-        options.buffer_height,
-        options.type,
-        options.pixel_space,
-        options.line_space,
-        cb
-      ])
-    }
-    return readPromise.apply(this, [
+    return runJob(read, this, [
       x,
       y,
       width,
@@ -952,8 +1153,9 @@ gdal.RasterBandPixels.prototype.readAsync = (function () {
       options.buffer_height,
       options.type,
       options.pixel_space,
-      options.line_space
-    ])
+      options.line_space,
+      options.resampling
+    ], options, cb)
   }
 })()
 
@@ -961,7 +1163,6 @@ gdal.RasterBandPixels.prototype.write = (function () {
   const write = gdal.RasterBandPixels.prototype.write
   return function (x, y, width, height, data, options) {
     if (!options) options = {}
-    if (data) data._gdal_type = getTypedArrayType(data)
     return write.apply(this, [
       x,
       y,
@@ -970,6 +1171,7 @@ gdal.RasterBandPixels.prototype.write = (function () {
       data,
       options.buffer_width,
       options.buffer_height,
+      options.type,
       options.pixel_space,
       options.line_space
     ])
@@ -977,30 +1179,14 @@ gdal.RasterBandPixels.prototype.write = (function () {
 })()
 
 gdal.RasterBandPixels.prototype.writeAsync = (function () {
-  const writeCb = gdal.RasterBandPixels.prototype.writeAsync
-  const writePromise = promisify(gdal.RasterBandPixels.prototype.writeAsync)
+  const write = gdal.RasterBandPixels.prototype.writeAsync
   return function (x, y, width, height, data, options, cb) {
     if (typeof arguments[arguments.length - 1] === 'function' && cb === undefined) {
       cb = arguments[arguments.length - 1]
       arguments[arguments.length - 1] = undefined
     }
     if (!options) options = {}
-    if (data) data._gdal_type = getTypedArrayType(data)
-    if (cb) {
-      return writeCb.apply(this, [
-        x,
-        y,
-        width,
-        height,
-        data,
-        options.buffer_width,
-        options.buffer_height,
-        options.pixel_space,
-        options.line_space,
-        cb
-      ])
-    }
-    return writePromise.apply(this, [
+    return runJob(write, this, [
       x,
       y,
       width,
@@ -1008,24 +1194,82 @@ gdal.RasterBandPixels.prototype.writeAsync = (function () {
       data,
       options.buffer_width,
       options.buffer_height,
+      options.type,
       options.pixel_space,
       options.line_space
-    ])
+    ], options, cb)
+  }
+})()
+
+const datasetPixelsArgs = (x, y, width, height, data, options) => [
+  x,
+  y,
+  width,
+  height,
+  data,
+  options.bands,
+  options.buffer_width,
+  options.buffer_height,
+  options.type,
+  options.pixel_space,
+  options.line_space,
+  options.band_space
+]
+
+gdal.DatasetPixels.prototype.read = (function () {
+  const read = gdal.DatasetPixels.prototype.read
+  return function (x, y, width, height, data, options) {
+    if (!options) options = {}
+    return read.apply(this, datasetPixelsArgs(x, y, width, height, data, options).concat([ options.resampling ]))
+  }
+})()
+
+gdal.DatasetPixels.prototype.readAsync = (function () {
+  const read = gdal.DatasetPixels.prototype.readAsync
+  return function (x, y, width, height, data, options, cb) {
+    if (typeof arguments[arguments.length - 1] === 'function' && cb === undefined) {
+      cb = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    if (!options) options = {}
+    return runJob(read, this, datasetPixelsArgs(x, y, width, height, data, options).concat([ options.resampling ]), options, cb)
+  }
+})()
+
+gdal.DatasetPixels.prototype.write = (function () {
+  const write = gdal.DatasetPixels.prototype.write
+  return function (x, y, width, height, data, options) {
+    return write.apply(this, datasetPixelsArgs(x, y, width, height, data, options || {}))
   }
 })()
 
-gdal.RasterBandPixels.prototype.readBlock = (function () {
-  const readBlock = gdal.RasterBandPixels.prototype.readBlock
-  return function (x, y, data) {
-    if (data) data._gdal_type = getTypedArrayType(data)
-    return readBlock.apply(this, arguments)
+gdal.DatasetPixels.prototype.writeAsync = (function () {
+  const write = gdal.DatasetPixels.prototype.writeAsync
+  return function (x, y, width, height, data, options, cb) {
+    if (typeof arguments[arguments.length - 1] === 'function' && cb === undefined) {
+      cb = arguments[arguments.length - 1]
+      arguments[arguments.length - 1] = undefined
+    }
+    if (!options) options = {}
+    return runJob(write, this, datasetPixelsArgs(x, y, width, height, data, options), options, cb)
   }
 })()
 
-gdal.RasterBandPixels.prototype.writeBlock = (function () {
-  const writeBlock = gdal.RasterBandPixels.prototype.writeBlock
-  return function (x, y, data) {
-    data._gdal_type = getTypedArrayType(data)
-    return writeBlock.apply(this, arguments)
+gdal.vsijs.register = (function () {
+  const register = gdal.vsijs.register
+  return function (name, size, read, options) {
+    if (typeof read !== 'function') throw new TypeError('read must be a function')
+    if (!options) options = {}
+    const reader = (offset, length, cb) => {
+      let data
+      try {
+        data = read(offset, length)
+      } catch (e) {
+        cb(e)
+        return
+      }
+      Promise.resolve(data).then((data) => cb(null, data), (e) => cb(e || new Error('Read failed')))
+    }
+    return register.call(this, name, size, reader, options.blockSize, options.readAhead)
   }
 })()
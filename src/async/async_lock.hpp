@@ -0,0 +1,150 @@
+#ifndef __NODE_GDAL_ASYNC_LOCK_H__
+#define __NODE_GDAL_ASYNC_LOCK_H__
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <vector>
+
+// node
+#include <uv.h>
+
+namespace node_gdal {
+
+/**
+ * The async lock of a dataset
+ *
+ * It is shared by the dataset and by the async jobs using it: a job
+ * queued before the dataset was closed keeps the mutex alive and
+ * finds closed set once it gets the lock
+ *
+ * A job registers the locks of its datasets on its thread while it uses
+ * them (enter/leave), so that a blocking read that needs the event loop
+ * (/vsijs/) can give up once closing is set instead of deadlocking the
+ * main thread waiting for the lock in PtrManager::dispose
+ */
+class AsyncLock {
+    public:
+  AsyncLock() : closed(false), closing(false) {
+    uv_mutex_init(&mutex);
+  }
+  ~AsyncLock() {
+    uv_mutex_destroy(&mutex);
+  }
+
+  void lock() {
+    uv_mutex_lock(&mutex);
+  }
+  void unlock() {
+    uv_mutex_unlock(&mutex);
+  }
+
+  AsyncLock(const AsyncLock &) = delete;
+  AsyncLock &operator=(const AsyncLock &) = delete;
+
+  // set by PtrManager::dispose, with the lock held
+  bool closed;
+  // set by PtrManager::dispose before it waits for the lock
+  std::atomic<bool> closing;
+
+  static void enter(AsyncLock *lock) {
+    current().push_back(lock);
+  }
+  static void leave(AsyncLock *lock) {
+    std::vector<AsyncLock *> &locks = current();
+    auto it = std::find(locks.begin(), locks.end(), lock);
+    if (it != locks.end()) locks.erase(it);
+  }
+  // The locks used by the job running on the current thread
+  static std::vector<AsyncLock *> &current() {
+    static thread_local std::vector<AsyncLock *> locks;
+    return locks;
+  }
+  // true if a dataset used by the current job is being closed
+  static bool cancelled() {
+    for (AsyncLock *lock : current())
+      if (lock->closing) return true;
+    return false;
+  }
+
+    private:
+  uv_mutex_t mutex;
+};
+
+typedef std::shared_ptr<AsyncLock> AsyncLockRef;
+
+/**
+ * Registers the lock of a dataset on the current thread for the duration
+ * of a job, without taking it: for the jobs that read a pooled handle or
+ * that manage the lock themselves
+ */
+class AsyncLockScope {
+    public:
+  explicit AsyncLockScope(const AsyncLockRef &lock) : lock(lock.get()) {
+    if (this->lock != nullptr) AsyncLock::enter(this->lock);
+  }
+  ~AsyncLockScope() {
+    if (lock != nullptr) AsyncLock::leave(lock);
+  }
+
+  AsyncLockScope(const AsyncLockScope &) = delete;
+  AsyncLockScope &operator=(const AsyncLockScope &) = delete;
+
+    private:
+  AsyncLock *lock;
+};
+
+/**
+ * Holds the async locks of all the datasets used by an operation
+ *
+ * The locks are always acquired in the same (address) order, so that
+ * two operations sharing datasets cannot deadlock, and each one is
+ * acquired only once, so that an operation can use two bands of the
+ * same dataset. nullptr entries (optional objects) are skipped
+ *
+ * The locks are released in reverse order when the guard goes out of
+ * scope, including when a job throws. The guard itself throws if one
+ * of the datasets was closed while the operation was queued
+ */
+class AsyncLockGuard {
+    public:
+  explicit AsyncLockGuard(std::initializer_list<AsyncLockRef> list) : locks() {
+    for (const AsyncLockRef &lock : list)
+      if (lock != nullptr) locks.push_back(lock.get());
+    std::sort(locks.begin(), locks.end(), std::less<AsyncLock *>());
+    locks.erase(std::unique(locks.begin(), locks.end()), locks.end());
+    for (AsyncLock *lock : locks) {
+      lock->lock();
+      AsyncLock::enter(lock);
+    }
+    for (AsyncLock *lock : locks)
+      if (lock->closed) {
+        release();
+        throw "Dataset object has already been destroyed";
+      }
+  }
+
+  ~AsyncLockGuard() {
+    release();
+  }
+
+  AsyncLockGuard(const AsyncLockGuard &) = delete;
+  AsyncLockGuard &operator=(const AsyncLockGuard &) = delete;
+
+    private:
+  // the references held by the caller keep the locks alive
+  std::vector<AsyncLock *> locks;
+
+  void release() {
+    for (auto lock = locks.rbegin(); lock != locks.rend(); lock++) {
+      AsyncLock::leave(*lock);
+      (*lock)->unlock();
+    }
+    locks.clear();
+  }
+};
+
+} // namespace node_gdal
+#endif
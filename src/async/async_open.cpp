@@ -6,20 +6,36 @@ namespace node_gdal {
 
 const char AsyncOpenLabel[] = "node-gdal:OpenDataset";
 
-AsyncOpen::AsyncOpen(Nan::Callback *pCallback, const std::function<GDALDataset *()> doit)
-  : Nan::AsyncWorker(pCallback, AsyncOpenLabel), doit(doit) {
+AsyncOpen::AsyncOpen(
+  Nan::Callback *pCallback, const std::function<GDALDataset *()> doit, DatasetPoolRef pool, AsyncProgress *progress)
+  : Nan::AsyncWorker(pCallback, AsyncOpenLabel), doit(doit), raw(nullptr), pool(pool), progress(progress) {
+}
+
+AsyncOpen::~AsyncOpen() {
+  if (progress != nullptr) delete progress;
 }
 
 void AsyncOpen::Execute() {
   /* V8 objects are not acessible here */
+  if (progress != nullptr && progress->aborted()) {
+    this->SetErrorMessage(AsyncAbortedMessage);
+    return;
+  }
   raw = doit();
-  if (!raw) { this->SetErrorMessage("Error opening dataset"); }
+  if (!raw) {
+    this->SetErrorMessage(progress != nullptr && progress->aborted() ? AsyncAbortedMessage : "Error opening dataset");
+  }
+}
+
+void AsyncOpen::WorkComplete() {
+  if (progress != nullptr) progress->flush();
+  Nan::AsyncWorker::WorkComplete();
 }
 
 void AsyncOpen::HandleOKCallback() {
   Nan::HandleScope scope;
 
-  Local<v8::Value> argv[] = {Nan::Undefined(), Dataset::New(raw)};
+  Local<v8::Value> argv[] = {Nan::Undefined(), Dataset::New(raw, pool)};
   Nan::Call(callback->GetFunction(), Nan::GetCurrentContext()->Global(), 2, argv);
 }
 
@@ -17,6 +17,8 @@
 #include <gdal_priv.h>
 
 #include "../gdal_dataset.hpp"
+#include "async_progress.hpp"
+#include "thread_pool.hpp"
 
 namespace node_gdal {
 
@@ -25,16 +27,27 @@ namespace node_gdal {
  *
  * The caller must provide a lambda that can be executed in
  * another thread with the proper open sequence
+ *
+ * The worker owns the optional progress object, the lambda
+ * should pass it to GDAL
  */
 class AsyncOpen : public Nan::AsyncWorker {
     private:
   std::function<GDALDataset *()> doit;
   GDALDataset *raw;
+  DatasetPoolRef pool;
+  AsyncProgress *progress;
 
     public:
-  explicit AsyncOpen(Nan::Callback *pCallback, const std::function<GDALDataset *()> doit);
+  explicit AsyncOpen(
+    Nan::Callback *pCallback,
+    const std::function<GDALDataset *()> doit,
+    DatasetPoolRef pool = nullptr,
+    AsyncProgress *progress = nullptr);
+  ~AsyncOpen();
 
   void Execute();
+  void WorkComplete();
   void HandleOKCallback();
   void HandleErrorCallback();
 };
@@ -0,0 +1,103 @@
+#include "async_progress.hpp"
+
+namespace node_gdal {
+
+bool AsyncProgress::parse(const Nan::FunctionCallbackInfo<Value> &info, int num, AsyncProgress *&progress) {
+  Local<Function> progress_cb;
+  Local<Object> abort_flag;
+  progress = nullptr;
+
+  if (info.Length() > num && !info[num]->IsNull() && !info[num]->IsUndefined()) {
+    if (!info[num]->IsFunction()) {
+      Nan::ThrowTypeError("progress_cb must be a function");
+      return false;
+    }
+    progress_cb = info[num].As<Function>();
+  }
+  if (info.Length() > num + 1 && !info[num + 1]->IsNull() && !info[num + 1]->IsUndefined()) {
+    if (!info[num + 1]->IsInt32Array() || info[num + 1].As<Int32Array>()->Length() < 1) {
+      Nan::ThrowTypeError("abort flag must be an Int32Array");
+      return false;
+    }
+    abort_flag = info[num + 1].As<Object>();
+  }
+
+  if (!progress_cb.IsEmpty() || !abort_flag.IsEmpty()) progress = new AsyncProgress(progress_cb, abort_flag);
+  return true;
+}
+
+AsyncProgress::AsyncProgress(Local<Function> progress_cb, Local<Object> abort_flag)
+  : async(nullptr), callback(nullptr), resource(nullptr), flagHandle(), flag(nullptr), complete(0), pending(false) {
+  uv_mutex_init(&lock);
+  if (!progress_cb.IsEmpty()) {
+    callback = new Nan::Callback(progress_cb);
+    resource = new Nan::AsyncResource("node-gdal:Progress");
+    async = new uv_async_t;
+    uv_async_init(Nan::GetCurrentEventLoop(), async, asyncCallback);
+    async->data = this;
+  }
+  if (!abort_flag.IsEmpty()) {
+    // the backing store of a non-detached ArrayBuffer does not move
+    flagHandle.Reset(abort_flag);
+    Nan::TypedArrayContents<int32_t> contents(abort_flag);
+    flag = *contents;
+  }
+}
+
+AsyncProgress::~AsyncProgress() {
+  if (async != nullptr) {
+    // the last event has been flushed, the job is complete
+    async->data = nullptr;
+    uv_close(reinterpret_cast<uv_handle_t *>(async), closeCallback);
+  }
+  if (callback != nullptr) delete callback;
+  if (resource != nullptr) delete resource;
+  flagHandle.Reset();
+  uv_mutex_destroy(&lock);
+}
+
+bool AsyncProgress::aborted() {
+  return flag != nullptr && *flag != 0;
+}
+
+int CPL_STDCALL AsyncProgress::progress(double complete, const char *, void *arg) {
+  AsyncProgress *self = static_cast<AsyncProgress *>(arg);
+  if (self == nullptr) return TRUE;
+
+  if (self->async != nullptr) {
+    uv_mutex_lock(&self->lock);
+    bool send = !self->pending && complete != self->complete;
+    self->complete = complete;
+    if (send) self->pending = true;
+    uv_mutex_unlock(&self->lock);
+    if (send) uv_async_send(self->async);
+  }
+
+  return self->aborted() ? FALSE : TRUE;
+}
+
+void AsyncProgress::flush() {
+  if (callback == nullptr) return;
+  Nan::HandleScope scope;
+
+  uv_mutex_lock(&lock);
+  bool send = pending;
+  double value = complete;
+  pending = false;
+  uv_mutex_unlock(&lock);
+
+  if (!send) return;
+  Local<Value> argv[] = {Nan::New<Number>(value)};
+  callback->Call(1, argv, resource);
+}
+
+void AsyncProgress::asyncCallback(uv_async_t *handle) {
+  AsyncProgress *self = static_cast<AsyncProgress *>(handle->data);
+  if (self != nullptr) self->flush();
+}
+
+void AsyncProgress::closeCallback(uv_handle_t *handle) {
+  delete reinterpret_cast<uv_async_t *>(handle);
+}
+
+} // namespace node_gdal
@@ -0,0 +1,63 @@
+#ifndef __NODE_GDAL_ASYNC_PROGRESS_H__
+#define __NODE_GDAL_ASYNC_PROGRESS_H__
+
+// node
+#include <node.h>
+#include <uv.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// gdal
+#include <gdal_priv.h>
+
+using namespace v8;
+
+namespace node_gdal {
+
+/**
+ * Progress reporting and cancellation of an async job
+ *
+ * progress() is a GDALProgressFunc called by GDAL on the worker thread,
+ * the last reported value is forwarded to the JS callback on the main
+ * thread through an uv_async_t, which coalesces the events: JS gets
+ * at most one call per event loop iteration
+ *
+ * The abort flag is an Int32Array shared with JS: the JS side sets it
+ * to a non-zero value (from the AbortSignal handler) and progress()
+ * then returns FALSE which makes GDAL interrupt the operation
+ *
+ * Must be created and destroyed on the main thread, the worker owns it
+ */
+class AsyncProgress {
+    public:
+  // Parses the optional progress callback at num and abort flag at num + 1
+  // Returns false if a JS exception has been thrown, progress is nullptr if neither is given
+  static bool parse(const Nan::FunctionCallbackInfo<Value> &info, int num, AsyncProgress *&progress);
+
+  AsyncProgress(Local<Function> progress_cb, Local<Object> abort_flag);
+  ~AsyncProgress();
+
+  static int CPL_STDCALL progress(double complete, const char *message, void *arg);
+  bool aborted();
+  // Delivers the last pending event, the worker calls it before its completion callback
+  void flush();
+
+    private:
+  static void asyncCallback(uv_async_t *handle);
+  static void closeCallback(uv_handle_t *handle);
+
+  uv_async_t *async;
+  uv_mutex_t lock;
+  Nan::Callback *callback;
+  Nan::AsyncResource *resource;
+  Nan::Persistent<Object> flagHandle;
+  volatile int32_t *flag;
+  double complete;
+  bool pending;
+};
+
+const char AsyncAbortedMessage[] = "Operation has been aborted";
+
+} // namespace node_gdal
+#endif
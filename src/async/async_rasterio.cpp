@@ -24,14 +24,12 @@ AsyncRasterIO::AsyncRasterIO(
   int nBufYSize,
   GDALDataType eBufType,
   int nPixelSpace,
-  int nLineSpace
-#if GDAL_VERSION_MAJOR >= 2
-  ,
-  GDALRasterIOExtraArg *psExtraArg
-#endif
-  )
+  int nLineSpace,
+  AsyncProgress *progress)
   : Nan::AsyncWorker(pCallback, AsyncRasterIOLabel),
     async_lock(pBand->async_lock),
+    pool(),
+    nBand(0),
     hDataPersistentHandle(*pObjectData),
     hBandPersistentHandle(pBand->handle()),
     pBand(pBand),
@@ -46,10 +44,25 @@ AsyncRasterIO::AsyncRasterIO(
     eBufType(eBufType),
     nPixelSpace(nPixelSpace),
     nLineSpace(nLineSpace),
+    progress(progress),
+    eErr(CE_None) {
 #if GDAL_VERSION_MAJOR >= 2
-    psExtraArg(psExtraArg),
+  INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+  if (progress != nullptr) {
+    sExtraArg.pfnProgress = AsyncProgress::progress;
+    sExtraArg.pProgressData = progress;
+  }
 #endif
-    eErr(CE_None) {
+  // Reads of the main bands of a pooled dataset can run in parallel
+  // Overviews and masks are not accessible by number and still use the main handle
+  if (pBand->pool && eRWFlag == GF_Read) {
+    GDALDataset *parent = pBand->getParent();
+    int n = pBand->get()->GetBand();
+    if (n >= 1 && n <= parent->GetRasterCount() && parent->GetRasterBand(n) == pBand->get()) {
+      pool = pBand->pool;
+      nBand = n;
+    }
+  }
 }
 
 /*
@@ -59,9 +72,45 @@ AsyncRasterIO::AsyncRasterIO(
  * ...however...
  * their backing stores are not allocated on the heap
  */
+AsyncRasterIO::~AsyncRasterIO() {
+  if (progress != nullptr) delete progress;
+}
+
+#if GDAL_VERSION_MAJOR >= 2
+void AsyncRasterIO::setWindow(const RasterIOWindow &window) {
+  window.apply(&sExtraArg);
+}
+#endif
+
 void AsyncRasterIO::Execute() {
-  uv_mutex_lock(async_lock);
-  eErr = this->pBand->get()->RasterIO(
+  // an aborted job that is still queued does not even take the lock
+  if (progress != nullptr && progress->aborted()) {
+    this->SetErrorMessage(AsyncAbortedMessage);
+    return;
+  }
+
+  AsyncLockScope scope(async_lock);
+  GDALDataset *pooled = nullptr;
+  GDALRasterBand *gdal_band;
+  if (pool) {
+    pooled = pool->acquire();
+    if (pooled == nullptr) {
+      this->SetErrorMessage(
+        pool->isClosed() ? "Dataset object has already been destroyed" : "Error opening pooled dataset");
+      return;
+    }
+    gdal_band = pooled->GetRasterBand(nBand);
+  } else {
+    async_lock->lock();
+    if (async_lock->closed) {
+      async_lock->unlock();
+      this->SetErrorMessage("Dataset object has already been destroyed");
+      return;
+    }
+    gdal_band = this->pBand->get();
+  }
+
+  eErr = gdal_band->RasterIO(
     eRWFlag,
     nXOff,
     nYOff,
@@ -75,12 +124,25 @@ void AsyncRasterIO::Execute() {
     nLineSpace
 #if GDAL_VERSION_MAJOR >= 2
     ,
-    psExtraArg
+    &sExtraArg
 #endif
   );
 
-  if (eErr != CE_None) { this->SetErrorMessage(std::to_string((int)eErr).c_str()); }
-  uv_mutex_unlock(async_lock);
+  if (eErr != CE_None) {
+    if (progress != nullptr && progress->aborted())
+      this->SetErrorMessage(AsyncAbortedMessage);
+    else
+      this->SetErrorMessage(std::to_string((int)eErr).c_str());
+  }
+  if (pooled)
+    pool->release(pooled);
+  else
+    async_lock->unlock();
+}
+
+void AsyncRasterIO::WorkComplete() {
+  if (progress != nullptr) progress->flush();
+  Nan::AsyncWorker::WorkComplete();
 }
 
 void AsyncRasterIO::HandleOKCallback() {
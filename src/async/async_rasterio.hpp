@@ -14,6 +14,12 @@
 // gdal
 #include <gdal_priv.h>
 
+#include "../utils/dataset_pool.hpp"
+#include "../utils/rasterio_window.hpp"
+#include "async_lock.hpp"
+#include "async_progress.hpp"
+#include "thread_pool.hpp"
+
 namespace node_gdal {
 
 /**
@@ -26,7 +32,10 @@ namespace node_gdal {
  */
 class AsyncRasterIO : public Nan::AsyncWorker {
     private:
-  uv_mutex_t *async_lock;
+  AsyncLockRef async_lock;
+  // set when the read can be done on a pooled handle, nBand is the band number on that handle
+  DatasetPoolRef pool;
+  int nBand;
   Nan::Persistent<v8::Object> hDataPersistentHandle;
   Nan::Persistent<v8::Object> hBandPersistentHandle;
   RasterBand *pBand;
@@ -42,8 +51,9 @@ class AsyncRasterIO : public Nan::AsyncWorker {
   int nPixelSpace;
   int nLineSpace;
 #if GDAL_VERSION_MAJOR >= 2
-  GDALRasterIOExtraArg *psExtraArg;
+  GDALRasterIOExtraArg sExtraArg;
 #endif
+  AsyncProgress *progress;
   CPLErr eErr;
 
     public:
@@ -61,14 +71,17 @@ class AsyncRasterIO : public Nan::AsyncWorker {
     int nBufYSize,
     GDALDataType eBufType,
     int nPixelSpace,
-    int nLineSpace
+    int nLineSpace,
+    AsyncProgress *progress = nullptr);
+  ~AsyncRasterIO();
+
 #if GDAL_VERSION_MAJOR >= 2
-    ,
-    GDALRasterIOExtraArg *psExtraArg = (GDALRasterIOExtraArg *)nullptr
+  // resampling and fractional window of a read, the progress is kept
+  void setWindow(const RasterIOWindow &window);
 #endif
-  );
 
   void Execute();
+  void WorkComplete();
   void HandleOKCallback();
   void HandleErrorCallback();
 };
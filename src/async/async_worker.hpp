@@ -0,0 +1,195 @@
+#ifndef __NODE_GDAL_ASYNC_WORKER_H__
+#define __NODE_GDAL_ASYNC_WORKER_H__
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <vector>
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// gdal
+#include <gdal_priv.h>
+
+#include "../gdal_common.hpp"
+#include "async_progress.hpp"
+#include "thread_pool.hpp"
+
+using namespace v8;
+
+namespace node_gdal {
+
+/**
+ * This class handles generic async jobs
+ *
+ * main is executed in another thread and must not access V8,
+ * it reports errors by throwing a const char *
+ *
+ * rval is executed on the main thread once main has completed
+ * and converts the raw result to a JS value, it can also throw
+ * a const char * if the result cannot be delivered
+ *
+ * All JS objects in the persistent list are protected from
+ * the garbage collector until the job has completed
+ *
+ * The worker owns the optional progress object
+ */
+template <class GDALType> class GDALAsyncWorker : public Nan::AsyncWorker {
+    public:
+  typedef std::function<GDALType()> MainFunc;
+  typedef std::function<Local<Value>(const GDALType)> RValFunc;
+
+    private:
+  const MainFunc main;
+  const RValFunc rval;
+  GDALType raw;
+  AsyncProgress *progress;
+
+    public:
+  explicit GDALAsyncWorker(
+    Nan::Callback *pCallback,
+    const MainFunc &main,
+    const RValFunc &rval,
+    const std::vector<Local<Object>> &objects,
+    AsyncProgress *progress);
+  ~GDALAsyncWorker();
+
+  void Execute();
+  void WorkComplete();
+  void HandleOKCallback();
+};
+
+const char GDALAsyncWorkerLabel[] = "node-gdal:AsyncWorker";
+
+template <class GDALType>
+GDALAsyncWorker<GDALType>::GDALAsyncWorker(
+  Nan::Callback *pCallback,
+  const MainFunc &main,
+  const RValFunc &rval,
+  const std::vector<Local<Object>> &objects,
+  AsyncProgress *progress)
+  : Nan::AsyncWorker(pCallback, GDALAsyncWorkerLabel), main(main), rval(rval), raw(), progress(progress) {
+  for (uint32_t i = 0; i < objects.size(); i++) SaveToPersistent(i, objects[i]);
+}
+
+template <class GDALType> GDALAsyncWorker<GDALType>::~GDALAsyncWorker() {
+  if (progress != nullptr) delete progress;
+}
+
+template <class GDALType> void GDALAsyncWorker<GDALType>::Execute() {
+  /* V8 objects are not acessible here */
+  if (progress != nullptr && progress->aborted()) {
+    this->SetErrorMessage(AsyncAbortedMessage);
+    return;
+  }
+  try {
+    raw = main();
+  } catch (const char *err) {
+    this->SetErrorMessage(progress != nullptr && progress->aborted() ? AsyncAbortedMessage : err);
+  } catch (const std::exception &err) {
+    // std::bad_alloc & co would terminate the process on a pool thread
+    this->SetErrorMessage(err.what());
+  }
+}
+
+template <class GDALType> void GDALAsyncWorker<GDALType>::WorkComplete() {
+  if (progress != nullptr) progress->flush();
+  Nan::AsyncWorker::WorkComplete();
+}
+
+template <class GDALType> void GDALAsyncWorker<GDALType>::HandleOKCallback() {
+  Nan::HandleScope scope;
+
+  Local<Value> value;
+  try {
+    value = rval(raw);
+  } catch (const char *err) {
+    Local<Value> argv[] = {Nan::Error(err)};
+    Nan::Call(callback->GetFunction(), Nan::GetCurrentContext()->Global(), 1, argv);
+    return;
+  }
+  Local<Value> argv[] = {Nan::Undefined(), value};
+  Nan::Call(callback->GetFunction(), Nan::GetCurrentContext()->Global(), 2, argv);
+}
+
+/**
+ * A job that can be run either synchronously or asynchronously
+ *
+ * The sync and async versions of a method share the same argument
+ * parsing and the same main/rval lambdas, only the execution differs
+ *
+ * progress is optional and only used by the async version, main
+ * should pass it to GDAL with AsyncProgress::progress
+ */
+template <class GDALType> class GDALAsyncableJob {
+    public:
+  typedef typename GDALAsyncWorker<GDALType>::MainFunc MainFunc;
+  typedef typename GDALAsyncWorker<GDALType>::RValFunc RValFunc;
+
+  MainFunc main;
+  RValFunc rval;
+  AsyncProgress *progress;
+
+  GDALAsyncableJob() : main(), rval(), progress(nullptr), persistent() {
+  }
+
+  void persist(const Local<Object> &obj) {
+    persistent.push_back(obj);
+  }
+
+  void run(const Nan::FunctionCallbackInfo<Value> &info, bool async, int cb_arg) {
+    std::unique_ptr<AsyncProgress> owned(progress);
+    progress = nullptr;
+    if (async) {
+      Nan::Callback *callback;
+      NODE_ARG_CB(cb_arg, "callback", callback);
+      thread_pool.queue(new GDALAsyncWorker<GDALType>(callback, main, rval, persistent, owned.release()));
+      return;
+    }
+    try {
+      GDALType obj = main();
+      info.GetReturnValue().Set(rval(obj));
+    } catch (const char *err) {
+      Nan::ThrowError(err);
+    } catch (const std::exception &err) {
+      Nan::ThrowError(err.what());
+    }
+  }
+
+    private:
+  std::vector<Local<Object>> persistent;
+};
+
+// Declares a method that has both a sync and an async version
+#define GDAL_ASYNCABLE_DECLARE(method)                                                                                 \
+  static NAN_METHOD(method);                                                                                           \
+  static NAN_METHOD(method##Async);                                                                                    \
+  static void method##_do(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async)
+
+// Same as GDAL_ASYNCABLE_DECLARE for the functions of a namespace
+#define GDAL_ASYNCABLE_GLOBAL(method)                                                                                  \
+  NAN_METHOD(method);                                                                                                  \
+  NAN_METHOD(method##Async);                                                                                           \
+  void method##_do(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async)
+
+// Defines both versions, the body that follows receives info and async
+#define GDAL_ASYNCABLE_DEFINE(klass_method)                                                                            \
+  NAN_METHOD(klass_method) {                                                                                           \
+    klass_method##_do(info, false);                                                                                    \
+  }                                                                                                                    \
+  NAN_METHOD(klass_method##Async) {                                                                                    \
+    klass_method##_do(info, true);                                                                                     \
+  }                                                                                                                    \
+  void klass_method##_do(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async)
+
+#define SET_ASYNCABLE_METHOD(lcons, name, method)                                                                      \
+  Nan::SetPrototypeMethod(lcons, name, method);                                                                        \
+  Nan::SetPrototypeMethod(lcons, name "Async", method##Async)
+
+} // namespace node_gdal
+#endif
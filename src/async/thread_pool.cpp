@@ -0,0 +1,117 @@
+#include "thread_pool.hpp"
+
+#include <thread>
+
+namespace node_gdal {
+
+ThreadPool::ThreadPool()
+  : async(nullptr), jobs(), completed(), target(default_size), running(0), active(0), pending(0) {
+  uv_mutex_init(&lock);
+  uv_cond_init(&cond);
+}
+
+void ThreadPool::start() {
+  async = new uv_async_t;
+  uv_async_init(Nan::GetCurrentEventLoop(), async, asyncComplete);
+  async->data = this;
+  // the handle keeps the event loop alive only while there are pending jobs
+  uv_unref(reinterpret_cast<uv_handle_t *>(async));
+  while (running < target) spawn();
+}
+
+// must be called with the lock held or before the pool is started
+void ThreadPool::spawn() {
+  running++;
+  std::thread(threadMain, this).detach();
+}
+
+void ThreadPool::queue(Nan::AsyncWorker *worker) {
+  if (async == nullptr) {
+    uv_mutex_lock(&lock);
+    start();
+    uv_mutex_unlock(&lock);
+  }
+  if (pending++ == 0) uv_ref(reinterpret_cast<uv_handle_t *>(async));
+
+  uv_mutex_lock(&lock);
+  jobs.push_back(worker);
+  uv_cond_signal(&cond);
+  uv_mutex_unlock(&lock);
+}
+
+void ThreadPool::resize(unsigned int size) {
+  uv_mutex_lock(&lock);
+  target = size;
+  if (async != nullptr)
+    while (running < target) spawn();
+  // the idle threads above the target will exit
+  uv_cond_broadcast(&cond);
+  uv_mutex_unlock(&lock);
+}
+
+void ThreadPool::threadMain(void *arg) {
+  ThreadPool *pool = static_cast<ThreadPool *>(arg);
+
+  uv_mutex_lock(&pool->lock);
+  while (true) {
+    while (pool->jobs.empty() && pool->running <= pool->target) uv_cond_wait(&pool->cond, &pool->lock);
+    if (pool->running > pool->target) break;
+
+    Nan::AsyncWorker *worker = pool->jobs.front();
+    pool->jobs.pop_front();
+    pool->active++;
+    uv_mutex_unlock(&pool->lock);
+
+    /* V8 objects are not acessible here */
+    worker->Execute();
+
+    uv_mutex_lock(&pool->lock);
+    pool->active--;
+    pool->completed.push_back(worker);
+    uv_async_send(pool->async);
+  }
+  pool->running--;
+  uv_mutex_unlock(&pool->lock);
+}
+
+void ThreadPool::asyncComplete(uv_async_t *handle) {
+  ThreadPool *pool = static_cast<ThreadPool *>(handle->data);
+  std::deque<Nan::AsyncWorker *> done;
+
+  uv_mutex_lock(&pool->lock);
+  done.swap(pool->completed);
+  uv_mutex_unlock(&pool->lock);
+
+  for (Nan::AsyncWorker *worker : done) {
+    worker->WorkComplete();
+    worker->Destroy();
+  }
+
+  pool->pending -= done.size();
+  if (pool->pending == 0) uv_unref(reinterpret_cast<uv_handle_t *>(handle));
+}
+
+unsigned int ThreadPool::size() {
+  uv_mutex_lock(&lock);
+  unsigned int r = target;
+  uv_mutex_unlock(&lock);
+  return r;
+}
+
+unsigned int ThreadPool::busy() {
+  uv_mutex_lock(&lock);
+  unsigned int r = active;
+  uv_mutex_unlock(&lock);
+  return r;
+}
+
+unsigned int ThreadPool::queued() {
+  uv_mutex_lock(&lock);
+  unsigned int r = jobs.size();
+  uv_mutex_unlock(&lock);
+  return r;
+}
+
+ThreadPool thread_pool;
+
+} // namespace node_gdal
@@ -0,0 +1,65 @@
+#ifndef __NODE_GDAL_THREAD_POOL_H__
+#define __NODE_GDAL_THREAD_POOL_H__
+
+#include <deque>
+
+// node
+#include <node.h>
+#include <uv.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+using namespace v8;
+
+namespace node_gdal {
+
+/**
+ * A pool of threads dedicated to the GDAL async jobs
+ *
+ * GDAL operations can block for a long time, running them on the
+ * default libuv pool would starve fs, dns and zlib in the whole process
+ *
+ * Jobs are Nan::AsyncWorker objects: Execute() runs on a pool thread,
+ * WorkComplete() and Destroy() run on the main thread once it is done
+ *
+ * The threads are started when the first job is queued
+ */
+class ThreadPool {
+    public:
+  static const unsigned int default_size = 4;
+
+  ThreadPool();
+
+  void queue(Nan::AsyncWorker *worker);
+  void resize(unsigned int size);
+
+  unsigned int size();
+  unsigned int busy();
+  unsigned int queued();
+
+    private:
+  static void threadMain(void *arg);
+  static void asyncComplete(uv_async_t *handle);
+  void start();
+  void spawn();
+
+  uv_mutex_t lock;
+  uv_cond_t cond;
+  uv_async_t *async;
+  std::deque<Nan::AsyncWorker *> jobs;
+  std::deque<Nan::AsyncWorker *> completed;
+  // number of threads that should be running, the others exit
+  unsigned int target;
+  // number of threads actually running
+  unsigned int running;
+  unsigned int active;
+  // jobs queued but not yet completed on the main thread
+  unsigned int pending;
+};
+
+// replaces Nan::AsyncQueueWorker for all GDAL jobs
+extern ThreadPool thread_pool;
+
+} // namespace node_gdal
+#endif
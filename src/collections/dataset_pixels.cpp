@@ -0,0 +1,444 @@
+#include "dataset_pixels.hpp"
+#include "../gdal_common.hpp"
+#include "../gdal_dataset.hpp"
+#include "../utils/rasterio_window.hpp"
+#include "../utils/typed_array.hpp"
+
+#include <memory>
+#include <vector>
+
+namespace node_gdal {
+
+Nan::Persistent<FunctionTemplate> DatasetPixels::constructor;
+
+void DatasetPixels::Initialize(Local<Object> target) {
+  Nan::HandleScope scope;
+
+  Local<FunctionTemplate> lcons = Nan::New<FunctionTemplate>(DatasetPixels::New);
+  lcons->InstanceTemplate()->SetInternalFieldCount(1);
+  lcons->SetClassName(Nan::New("DatasetPixels").ToLocalChecked());
+
+  Nan::SetPrototypeMethod(lcons, "toString", toString);
+  SET_ASYNCABLE_METHOD(lcons, "read", read);
+  SET_ASYNCABLE_METHOD(lcons, "write", write);
+
+  Nan::Set(target, Nan::New("DatasetPixels").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
+
+  constructor.Reset(lcons);
+}
+
+DatasetPixels::DatasetPixels() : Nan::ObjectWrap() {
+}
+
+DatasetPixels::~DatasetPixels() {
+}
+
+Dataset *DatasetPixels::parent(const Nan::FunctionCallbackInfo<v8::Value> &info) {
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Dataset *ds = Nan::ObjectWrap::Unwrap<Dataset>(parent);
+  if (!ds->isAlive()) {
+    Nan::ThrowError("Dataset object has already been destroyed");
+    return nullptr;
+  }
+#if GDAL_VERSION_MAJOR < 2
+  if (ds->uses_ogr) {
+    Nan::ThrowError("Dataset does not support raster pixels");
+    return nullptr;
+  }
+#endif
+  return ds;
+}
+
+/**
+ * The pixels of several bands of a {{#crossLink
+ * "gdal.Dataset"}}Dataset{{/crossLink}}, read or written with a single
+ * `GDALDataset::RasterIO` call.
+ *
+ * The bands are band-sequential in the buffer by default, the spacing
+ * options allow any other interleaving:
+ * ```
+ * // read RGB pixel-interleaved bytes
+ * var rgb = dataset.pixels.read(0, 0, 256, 256, null, {
+ *   bands: [1, 2, 3],
+ *   type: gdal.GDT_Byte,
+ *   pixel_space: 3,
+ *   band_space: 1
+ * });```
+ *
+ * @class gdal.DatasetPixels
+ */
+NAN_METHOD(DatasetPixels::New) {
+  Nan::HandleScope scope;
+
+  if (!info.IsConstructCall()) {
+    Nan::ThrowError("Cannot call constructor as function, you need to use 'new' keyword");
+    return;
+  }
+  if (info[0]->IsExternal()) {
+    Local<External> ext = info[0].As<External>();
+    void *ptr = ext->Value();
+    DatasetPixels *f = static_cast<DatasetPixels *>(ptr);
+    f->Wrap(info.This());
+    info.GetReturnValue().Set(info.This());
+    return;
+  } else {
+    Nan::ThrowError("Cannot create DatasetPixels directly");
+    return;
+  }
+}
+
+Local<Value> DatasetPixels::New(Local<Value> ds_obj) {
+  Nan::EscapableHandleScope scope;
+
+  DatasetPixels *wrapped = new DatasetPixels();
+
+  v8::Local<v8::Value> ext = Nan::New<External>(wrapped);
+  v8::Local<v8::Object> obj =
+    Nan::NewInstance(Nan::GetFunction(Nan::New(DatasetPixels::constructor)).ToLocalChecked(), 1, &ext)
+      .ToLocalChecked();
+  Nan::SetPrivate(obj, Nan::New("parent_").ToLocalChecked(), ds_obj);
+
+  return scope.Escape(obj);
+}
+
+NAN_METHOD(DatasetPixels::toString) {
+  Nan::HandleScope scope;
+  info.GetReturnValue().Set(Nan::New("DatasetPixels").ToLocalChecked());
+}
+
+/**
+ * Low level RasterIO for both reading and writing, synchronous and asynchronous.
+ */
+void DatasetPixels::_do_rasterio(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async, GDALRWFlag flag) {
+  Nan::HandleScope scope;
+
+  Dataset *ds;
+  if ((ds = parent(info)) == nullptr) return;
+
+  GDALDataset *raw = ds->getDataset();
+  RasterIOWindow window;
+  int x, y, w, h;
+  int buffer_w, buffer_h;
+  int bytes_per_pixel;
+  int pixel_space, line_space, band_space;
+  int min_size, min_length;
+  void *data;
+  Local<Array> band_list;
+  Local<Object> obj;
+  GDALDataType type;
+
+  // reads also take a resampling algorithm and a fractional window
+  if (flag == GF_Write) {
+    NODE_ARG_INT(0, "x_offset", x);
+    NODE_ARG_INT(1, "y_offset", y);
+    NODE_ARG_INT(2, "x_size", w);
+    NODE_ARG_INT(3, "y_size", h);
+    window.x = x;
+    window.y = y;
+    window.w = w;
+    window.h = h;
+    NODE_ARG_OBJECT(4, "data", obj);
+  } else {
+    if (window.parse(info, 0, 12)) return; // error parsing window
+    x = window.x;
+    y = window.y;
+    w = window.w;
+    h = window.h;
+    NODE_ARG_OBJECT_OPT(4, "data", obj);
+  }
+  NODE_ARG_ARRAY_OPT(5, "bands", band_list);
+
+  buffer_w = w;
+  buffer_h = h;
+  NODE_ARG_INT_OPT(6, "buffer_width", buffer_w);
+  NODE_ARG_INT_OPT(7, "buffer_height", buffer_h);
+
+  ds->async_lock->lock();
+  int n_raster_bands = raw->GetRasterCount();
+  ds->async_lock->unlock();
+
+  std::shared_ptr<std::vector<int>> bands(new std::vector<int>());
+  if (!band_list.IsEmpty()) {
+    for (unsigned int i = 0; i < band_list->Length(); i++) {
+      Local<Value> val = Nan::Get(band_list, i).ToLocalChecked();
+      if (!val->IsNumber()) {
+        Nan::ThrowError("band array must only contain numbers");
+        return;
+      }
+      int band = Nan::To<int32_t>(val).ToChecked();
+      if (band > n_raster_bands || band < 1) {
+        Nan::ThrowError("invalid band id");
+        return;
+      }
+      bands->push_back(band);
+    }
+  } else {
+    for (int i = 1; i <= n_raster_bands; i++) bands->push_back(i);
+  }
+  if (bands->empty()) {
+    Nan::ThrowError("No bands to read or write");
+    return;
+  }
+
+  // raw memory holds data_type (the type of the first band by default)
+  if (obj.IsEmpty() || TypedArray::IsRawMemory(obj)) {
+    std::string type_name = "";
+    ds->async_lock->lock();
+    type = raw->GetRasterBand((*bands)[0])->GetRasterDataType();
+    ds->async_lock->unlock();
+    NODE_ARG_OPT_STR(8, "data_type", type_name);
+    if (!type_name.empty()) { type = GDALGetDataTypeByName(type_name.c_str()); }
+  } else {
+    type = TypedArray::Identify(obj);
+    if (type == GDT_Unknown) {
+      Nan::ThrowError("Invalid array");
+      return;
+    }
+  }
+
+  bytes_per_pixel = GDALGetDataTypeSize(type) / 8;
+  if (bytes_per_pixel == 0) {
+    Nan::ThrowError("Invalid data_type");
+    return;
+  }
+  pixel_space = bytes_per_pixel;
+  NODE_ARG_INT_OPT(9, "pixel_space", pixel_space);
+  line_space = pixel_space * buffer_w;
+  NODE_ARG_INT_OPT(10, "line_space", line_space);
+  band_space = line_space * buffer_h;
+  NODE_ARG_INT_OPT(11, "band_space", band_space);
+
+  if (pixel_space < bytes_per_pixel) {
+    Nan::ThrowError("pixel_space must be greater than or equal to size of data_type");
+    return;
+  }
+  if (line_space < pixel_space * buffer_w) {
+    Nan::ThrowError("line_space must be greater than or equal to pixel_space * buffer_w");
+    return;
+  }
+  if (band_space < bytes_per_pixel) {
+    Nan::ThrowError("band_space must be greater than or equal to size of data_type");
+    return;
+  }
+
+  // offset of the last value + its size, the padding after it is not accessed
+  min_size = (buffer_h - 1) * line_space + (buffer_w - 1) * pixel_space +
+    (static_cast<int>(bands->size()) - 1) * band_space + bytes_per_pixel;
+  min_length = (min_size + bytes_per_pixel - 1) / bytes_per_pixel;
+
+  // create array if no array was passed
+  if (obj.IsEmpty()) {
+    Local<Value> array = TypedArray::New(type, min_length);
+    if (array.IsEmpty() || !array->IsObject()) {
+      return; // TypedArray::New threw an error
+    }
+    obj = array.As<Object>();
+  }
+
+  data = TypedArray::Validate(obj, type, min_length);
+  if (!data) {
+    return; // TypedArray::Validate threw an error
+  }
+
+  int progress_arg = flag == GF_Read ? 13 : 12;
+  GDALAsyncableJob<CPLErr> job;
+  if (async && !AsyncProgress::parse(info, progress_arg, job.progress)) return;
+  job.persist(Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>());
+
+  // returned by rval, it also protects the array from the GC while the job is running
+  std::shared_ptr<Nan::Persistent<Object>> data_ref(new Nan::Persistent<Object>(obj), [](Nan::Persistent<Object> *p) {
+    p->Reset();
+    delete p;
+  });
+
+  // Reads of a pooled dataset can run in parallel
+  DatasetPoolRef pool = flag == GF_Read ? ds->pool : nullptr;
+  AsyncLockRef async_lock = ds->async_lock;
+  AsyncProgress *progress = job.progress;
+  job.main = [raw, pool, async_lock, flag, window, data, buffer_w, buffer_h, type, bands, pixel_space, line_space,
+              band_space, progress]() {
+    AsyncLockScope scope(async_lock);
+    GDALDataset *gdal_ds = raw;
+    if (pool) {
+      gdal_ds = pool->acquire();
+      if (gdal_ds == nullptr) {
+        if (pool->isClosed()) throw "Dataset object has already been destroyed";
+        throw "Error opening pooled dataset";
+      }
+    } else {
+      async_lock->lock();
+      if (async_lock->closed) {
+        async_lock->unlock();
+        throw "Dataset object has already been destroyed";
+      }
+    }
+#if GDAL_VERSION_MAJOR >= 2
+    GDALRasterIOExtraArg sExtraArg;
+    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+    window.apply(&sExtraArg);
+    if (progress) {
+      sExtraArg.pfnProgress = AsyncProgress::progress;
+      sExtraArg.pProgressData = progress;
+    }
+#endif
+    CPLErr err = gdal_ds->RasterIO(
+      flag,
+      window.x,
+      window.y,
+      window.w,
+      window.h,
+      data,
+      buffer_w,
+      buffer_h,
+      type,
+      bands->size(),
+      bands->data(),
+      pixel_space,
+      line_space,
+      band_space
+#if GDAL_VERSION_MAJOR >= 2
+      ,
+      &sExtraArg
+#endif
+    );
+    if (pool)
+      pool->release(gdal_ds);
+    else
+      async_lock->unlock();
+    if (err != CE_None) throw CPLGetLastErrorMsg();
+    return err;
+  };
+  job.rval = [data_ref](CPLErr) -> Local<Value> { return Nan::New(*data_ref); };
+  job.run(info, async, progress_arg + 2);
+}
+
+/**
+ * Reads a region of pixels of several bands.
+ *
+ * @method read
+ * @throws Error
+ * @param {Number} x
+ * @param {Number} y
+ * @param {Number} width
+ * @param {Number} height
+ * @param {TypedArray|DataView|ArrayBuffer|SharedArrayBuffer} [data] The
+ * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
+ * (or Buffer) to put the data in, its type selects the data type. A `DataView`,
+ * `ArrayBuffer` or `SharedArrayBuffer` is filled with values of `options.type`.
+ * A new array is created if not given.
+ * @param {Object} [options]
+ * @param {Integer[]} [options.bands] The band numbers, all bands by default
+ * @param {Integer} [options.buffer_width=x_size]
+ * @param {Integer} [options.buffer_height=y_size]
+ * @param {String} [options.type] See {{#crossLink "Constants (GDT)"}}GDT
+ * constants{{/crossLink}}, the data type of the first band by default.
+ * @param {Integer} [options.pixel_space] Bytes between two pixels of a line
+ * @param {Integer} [options.line_space] Bytes between two lines of a band
+ * @param {Integer} [options.band_space] Bytes between two bands
+ * @param {String} [options.resampling=nearest] Resampling used when the buffer size differs from the window size:
+ * `nearest`, `bilinear`, `cubic`, `cubicspline`, `lanczos`, `average`, `mode` or `gauss`
+ * @return {TypedArray} A
+ * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
+ * of values.
+ */
+
+/**
+ * Asynchronously reads a region of pixels of several bands.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * All optional parameters before the callback can be omitted so the callback parameter can be at any position as long
+ * as it is the last parameter. Otherwise the function returns a Promise resolved with the result.
+ *
+ * @method readAsync
+ * @param {Number} x
+ * @param {Number} y
+ * @param {Number} width
+ * @param {Number} height
+ * @param {TypedArray|DataView|ArrayBuffer|SharedArrayBuffer} [data] The
+ * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
+ * (or Buffer) to put the data in, its type selects the data type. A `DataView`,
+ * `ArrayBuffer` or `SharedArrayBuffer` is filled with values of `options.type`.
+ * A new array is created if not given.
+ * @param {Object} [options]
+ * @param {Integer[]} [options.bands] The band numbers, all bands by default
+ * @param {Integer} [options.buffer_width=x_size]
+ * @param {Integer} [options.buffer_height=y_size]
+ * @param {String} [options.type] See {{#crossLink "Constants (GDT)"}}GDT
+ * constants{{/crossLink}}, the data type of the first band by default.
+ * @param {Integer} [options.pixel_space] Bytes between two pixels of a line
+ * @param {Integer} [options.line_space] Bytes between two lines of a band
+ * @param {Integer} [options.band_space] Bytes between two bands
+ * @param {String} [options.resampling=nearest] Resampling used when the buffer size differs from the window size:
+ * `nearest`, `bilinear`, `cubic`, `cubicspline`, `lanczos`, `average`, `mode` or `gauss`
+ * @param {Function} [options.progress_cb] progress callback, called with the completion ratio
+ * @param {AbortSignal} [options.signal] aborts the operation
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<TypedArray>} A
+ * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
+ * of values.
+ */
+GDAL_ASYNCABLE_DEFINE(DatasetPixels::read) {
+  _do_rasterio(info, async, GF_Read);
+}
+
+/**
+ * Writes a region of pixels of several bands.
+ *
+ * @method write
+ * @throws Error
+ * @param {Integer} x
+ * @param {Integer} y
+ * @param {Integer} width
+ * @param {Integer} height
+ * @param {TypedArray|DataView|ArrayBuffer|SharedArrayBuffer} data The
+ * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
+ * (or Buffer) to write, its type selects the data type. A `DataView`,
+ * `ArrayBuffer` or `SharedArrayBuffer` holds values of `options.type`.
+ * @param {Object} [options]
+ * @param {Integer[]} [options.bands] The band numbers, all bands by default
+ * @param {Integer} [options.buffer_width=x_size]
+ * @param {Integer} [options.buffer_height=y_size]
+ * @param {String} [options.type] See {{#crossLink "Constants (GDT)"}}GDT
+ * constants{{/crossLink}}, the data type of the first band by default.
+ * @param {Integer} [options.pixel_space] Bytes between two pixels of a line
+ * @param {Integer} [options.line_space] Bytes between two lines of a band
+ * @param {Integer} [options.band_space] Bytes between two bands
+ * @return {TypedArray} The written data
+ */
+
+/**
+ * Asynchronously writes a region of pixels of several bands.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * All optional parameters before the callback can be omitted so the callback parameter can be at any position as long
+ * as it is the last parameter. Otherwise the function returns a Promise resolved with the result.
+ *
+ * @method writeAsync
+ * @param {Integer} x
+ * @param {Integer} y
+ * @param {Integer} width
+ * @param {Integer} height
+ * @param {TypedArray|DataView|ArrayBuffer|SharedArrayBuffer} data The
+ * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
+ * (or Buffer) to write, its type selects the data type. A `DataView`,
+ * `ArrayBuffer` or `SharedArrayBuffer` holds values of `options.type`.
+ * @param {Object} [options]
+ * @param {Integer[]} [options.bands] The band numbers, all bands by default
+ * @param {Integer} [options.buffer_width=x_size]
+ * @param {Integer} [options.buffer_height=y_size]
+ * @param {String} [options.type] See {{#crossLink "Constants (GDT)"}}GDT
+ * constants{{/crossLink}}, the data type of the first band by default.
+ * @param {Integer} [options.pixel_space] Bytes between two pixels of a line
+ * @param {Integer} [options.line_space] Bytes between two lines of a band
+ * @param {Integer} [options.band_space] Bytes between two bands
+ * @param {Function} [options.progress_cb] progress callback, called with the completion ratio
+ * @param {AbortSignal} [options.signal] aborts the operation
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<TypedArray>} The written data
+ */
+GDAL_ASYNCABLE_DEFINE(DatasetPixels::write) {
+  _do_rasterio(info, async, GF_Write);
+}
+
+} // namespace node_gdal
@@ -0,0 +1,44 @@
+#ifndef __NODE_GDAL_DATASET_PIXELS_H__
+#define __NODE_GDAL_DATASET_PIXELS_H__
+
+// node
+#include <node.h>
+#include <node_object_wrap.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// gdal
+#include <gdal_priv.h>
+
+#include "../async/async_worker.hpp"
+#include "../gdal_dataset.hpp"
+
+using namespace v8;
+using namespace node;
+
+namespace node_gdal {
+
+class DatasetPixels : public Nan::ObjectWrap {
+    public:
+  static Nan::Persistent<FunctionTemplate> constructor;
+
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(New);
+  static Local<Value> New(Local<Value> ds_obj);
+  static NAN_METHOD(toString);
+
+  GDAL_ASYNCABLE_DECLARE(read);
+  GDAL_ASYNCABLE_DECLARE(write);
+
+  static void _do_rasterio(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async, GDALRWFlag flag);
+  static Dataset *parent(const Nan::FunctionCallbackInfo<v8::Value> &info);
+
+  DatasetPixels();
+
+    private:
+  ~DatasetPixels();
+};
+
+} // namespace node_gdal
+#endif
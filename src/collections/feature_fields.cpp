@@ -1,6 +1,7 @@
 #include "../gdal_common.hpp"
 #include "../gdal_feature.hpp"
 #include "feature_fields.hpp"
+#include "../utils/field_names.hpp"
 
 namespace node_gdal {
 
@@ -150,26 +151,26 @@ NAN_METHOD(FeatureFields::set) {
       // set({})
       Local<Object> values = info[0].As<Object>();
 
-      n = f->get()->GetFieldCount();
+      // the getters of the passed object can evict the cache entry
+      std::vector<Local<String>> keys;
+      std::vector<int> indices;
+      FieldNames::get(f->get()->GetDefnRef())->copy(keys, indices);
+      n = static_cast<unsigned int>(keys.size());
       n_fields_set = 0;
 
       for (i = 0; i < n; i++) {
         // iterate through field names from field defn,
         // grabbing values from passed object, if not undefined
 
-        OGRFieldDefn *field_def = f->get()->GetFieldDefnRef(i);
-
-        const char *field_name = field_def->GetNameRef();
+        Local<String> field_name = keys[i];
 
-        field_index = f->get()->GetFieldIndex(field_name);
+        // a duplicate name sets the first field with this name
+        field_index = indices[i];
 
-        // skip value if field name doesnt exist
-        // both in the feature definition and the passed object
-        if (field_index == -1 || !Nan::HasOwnProperty(values, Nan::New(field_name).ToLocalChecked()).FromMaybe(false)) {
-          continue;
-        }
+        // skip value if field name doesnt exist in the passed object
+        if (!Nan::HasOwnProperty(values, field_name).FromMaybe(false)) { continue; }
 
-        Local<Value> val = Nan::Get(values, Nan::New(field_name).ToLocalChecked()).ToLocalChecked();
+        Local<Value> val = Nan::Get(values, field_name).ToLocalChecked();
         if (setField(f->get(), field_index, val)) {
           Nan::ThrowError("Unsupported type of field value");
           return;
@@ -242,19 +243,18 @@ NAN_METHOD(FeatureFields::reset) {
   }
 
   Local<Object> values = info[0].As<Object>();
+  // the getters of the passed object can evict the cache entry
+  std::vector<Local<String>> keys;
+  std::vector<int> indices;
+  FieldNames::get(f->get()->GetDefnRef())->copy(keys, indices);
 
   for (i = 0; i < n; i++) {
     // iterate through field names from field defn,
     // grabbing values from passed object
 
-    OGRFieldDefn *field_def = f->get()->GetFieldDefnRef(i);
-
-    const char *field_name = field_def->GetNameRef();
-
-    field_index = f->get()->GetFieldIndex(field_name);
-    if (field_index == -1) continue;
+    field_index = indices[i];
 
-    Local<Value> val = Nan::Get(values, Nan::New(field_name).ToLocalChecked()).ToLocalChecked();
+    Local<Value> val = Nan::Get(values, keys[i]).ToLocalChecked();
     if (setField(f->get(), field_index, val)) {
       Nan::ThrowError("Unsupported type of field value");
       return;
@@ -334,28 +334,34 @@ NAN_METHOD(FeatureFields::toObject) {
     return;
   }
 
-  Local<Object> obj = Nan::New<Object>();
+  Local<Value> obj = FeatureFields::toObject(f->get());
+  if (obj.IsEmpty()) {
+    return; // get method threw an exception
+  }
+  info.GetReturnValue().Set(obj);
+}
 
-  int n = f->get()->GetFieldCount();
-  for (int i = 0; i < n; i++) {
+Local<Value> FeatureFields::toObject(OGRFeature *f) {
+  //#throws : caller must check if return_val.IsEmpty() and bail out if true
+  Nan::EscapableHandleScope scope;
 
-    // get field name
-    OGRFieldDefn *field_def = f->get()->GetFieldDefnRef(i);
-    const char *key = field_def->GetNameRef();
-    if (!key) {
-      Nan::ThrowError("Error getting field name");
-      return;
-    }
+  Local<Object> obj = Nan::New<Object>();
 
+  // cached keys, the objects of features of one layer share a hidden class
+  FieldNames *names = FieldNames::get(f->GetDefnRef());
+  int n = names->count();
+  for (int i = 0; i < n; i++) {
     // get field value
-    Local<Value> val = FeatureFields::get(f->get(), i);
+    Local<Value> val = FeatureFields::get(f, i);
     if (val.IsEmpty()) {
-      return; // get method threw an exception
+      return Local<Value>(); // get method threw an exception
     }
 
-    Nan::Set(obj, Nan::New(key).ToLocalChecked(), val);
+    // like an object literal, does not call the setters of Object.prototype
+    // which could run JS and evict names from the cache
+    obj->CreateDataProperty(Nan::GetCurrentContext(), names->name(i), val).FromMaybe(false);
   }
-  info.GetReturnValue().Set(obj);
+  return scope.Escape(obj);
 }
 
 /**
@@ -35,6 +35,7 @@ class FeatureFields : public Nan::ObjectWrap {
   static NAN_METHOD(indexOf);
 
   static Local<Value> get(OGRFeature *f, int field_index);
+  static Local<Value> toObject(OGRFeature *f);
   static Local<Value> getFieldAsIntegerList(OGRFeature *feature, int field_index);
 #if defined(GDAL_VERSION_MAJOR) && (GDAL_VERSION_MAJOR >= 2)
   static Local<Value> getFieldAsInteger64List(OGRFeature *feature, int field_index);
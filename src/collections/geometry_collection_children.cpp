@@ -2,6 +2,7 @@
 #include "../gdal_common.hpp"
 #include "../gdal_geometry.hpp"
 #include "../gdal_geometrycollection.hpp"
+#include "../utils/coordinates.hpp"
 
 namespace node_gdal {
 
@@ -19,6 +20,8 @@ void GeometryCollectionChildren::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "get", get);
   Nan::SetPrototypeMethod(lcons, "remove", remove);
   Nan::SetPrototypeMethod(lcons, "add", add);
+  Nan::SetPrototypeMethod(lcons, "toTypedArray", toTypedArray);
+  Nan::SetPrototypeMethod(lcons, "setFromTypedArray", setFromTypedArray);
 
   Nan::Set(target, Nan::New("GeometryCollectionChildren").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
 
@@ -200,4 +203,150 @@ NAN_METHOD(GeometryCollectionChildren::add) {
   return;
 }
 
+/**
+ * Returns the points of all the children as a single array of interleaved
+ * coordinates.
+ *
+ * Every line string, ring and point is a curve: `offsets[i]` is the index of
+ * the first point of curve `i` and `parts[j]` is the index of the first curve
+ * of child `j`. Both arrays end with the total count.
+ *
+ * @example
+ * ```
+ * const { coordinates, offsets, parts } = multiPolygon.children.toTypedArray();```
+ *
+ * @method toTypedArray
+ * @throws Error
+ * @param {Object} [options]
+ * @param {Integer} [options.dims] `2` (x, y) or `3` (x, y, z), defaults to the
+ * coordinate dimension of the collection
+ * @return {Object} `{coordinates: Float64Array, offsets: Int32Array, parts: Int32Array}`
+ */
+NAN_METHOD(GeometryCollectionChildren::toTypedArray) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  GeometryCollection *geom = Nan::ObjectWrap::Unwrap<GeometryCollection>(parent);
+
+  int dims = geom->get()->getCoordinateDimension() == 3 ? 3 : 2;
+  Local<Object> options;
+  NODE_ARG_OBJECT_OPT(0, "options", options);
+  if (!options.IsEmpty()) NODE_INT_FROM_OBJ_OPT(options, "dims", dims);
+  if (dims != 2 && dims != 3) {
+    Nan::ThrowRangeError("dims must be 2 or 3");
+    return;
+  }
+
+  Local<Value> coordinates, offsets, parts;
+  if (!Coordinates::Export(geom->get(), dims, &coordinates, &offsets, &parts)) return;
+
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, Nan::New("coordinates").ToLocalChecked(), coordinates);
+  Nan::Set(result, Nan::New("offsets").ToLocalChecked(), offsets);
+  Nan::Set(result, Nan::New("parts").ToLocalChecked(), parts);
+  info.GetReturnValue().Set(result);
+}
+
+/**
+ * Replaces all the children of a MultiPoint, MultiLineString or MultiPolygon,
+ * with the layout returned by `toTypedArray()`. Without `parts`, every curve
+ * is a child (every ring is a polygon for a MultiPolygon).
+ *
+ * @method setFromTypedArray
+ * @throws Error
+ * @param {Float64Array} coordinates interleaved coordinates of all the curves
+ * @param {Int32Array} offsets index of the first point of each curve, followed by the total number of points
+ * @param {Int32Array} [parts] index of the first curve of each child, followed by the total number of curves
+ * @param {Integer} [dims=2] `2` (x, y) or `3` (x, y, z)
+ */
+NAN_METHOD(GeometryCollectionChildren::setFromTypedArray) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  GeometryCollection *geom = Nan::ObjectWrap::Unwrap<GeometryCollection>(parent);
+
+  OGRGeometryCollection *collection = geom->get();
+  OGRwkbGeometryType type = wkbFlatten(collection->getGeometryType());
+  if (type != wkbMultiPoint && type != wkbMultiLineString && type != wkbMultiPolygon) {
+    Nan::ThrowError("Only MultiPoint, MultiLineString and MultiPolygon children can be set from arrays");
+    return;
+  }
+
+  if (info.Length() < 2) {
+    Nan::ThrowError("coordinates and offsets must be given");
+    return;
+  }
+  int dims = 2;
+  NODE_ARG_INT_OPT(3, "dims", dims);
+  if (dims != 2 && dims != 3) {
+    Nan::ThrowRangeError("dims must be 2 or 3");
+    return;
+  }
+
+  const double *coords;
+  const int32_t *offsets;
+  const int32_t *parts = nullptr;
+  int points, curves, children;
+  if (!Coordinates::ValidateCoordinates(info[0], dims, coords, points)) return;
+  if (!Coordinates::ValidateOffsets(info[1], "offsets", points, offsets, curves)) return;
+  if (info.Length() > 2 && !info[2]->IsUndefined() && !info[2]->IsNull()) {
+    if (!Coordinates::ValidateOffsets(info[2], "parts", curves, parts, children)) return;
+  } else {
+    children = curves;
+  }
+
+  if (type == wkbMultiPoint) {
+    for (int i = 0; i < curves; i++) {
+      if (offsets[i + 1] - offsets[i] > 1) {
+        Nan::ThrowError("MultiPoint curves must have at most one point");
+        return;
+      }
+    }
+    for (int i = 0; i < children; i++) {
+      if (parts != nullptr && parts[i + 1] - parts[i] != 1) {
+        Nan::ThrowError("MultiPoint children must have exactly one curve");
+        return;
+      }
+    }
+  } else if (type == wkbMultiLineString && parts != nullptr) {
+    for (int i = 0; i < children; i++) {
+      if (parts[i + 1] - parts[i] != 1) {
+        Nan::ThrowError("MultiLineString children must have exactly one curve");
+        return;
+      }
+    }
+  }
+
+  collection->empty();
+  for (int i = 0; i < children; i++) {
+    int first = parts != nullptr ? parts[i] : i;
+    int last = parts != nullptr ? parts[i + 1] : i + 1;
+    if (type == wkbMultiPoint) {
+      OGRPoint *point = new OGRPoint();
+      if (offsets[first + 1] > offsets[first]) {
+        const double *pos = coords + static_cast<size_t>(offsets[first]) * dims;
+        point->setX(pos[0]);
+        point->setY(pos[1]);
+        if (dims == 3) point->setZ(pos[2]);
+      }
+      collection->addGeometryDirectly(point);
+    } else if (type == wkbMultiLineString) {
+      OGRLineString *line = new OGRLineString();
+      Coordinates::SetCurve(
+        line, coords + static_cast<size_t>(offsets[first]) * dims, offsets[first + 1] - offsets[first], dims);
+      collection->addGeometryDirectly(line);
+    } else {
+      OGRPolygon *polygon = new OGRPolygon();
+      for (int j = first; j < last; j++) {
+        OGRLinearRing *ring = new OGRLinearRing();
+        Coordinates::SetCurve(ring, coords + static_cast<size_t>(offsets[j]) * dims, offsets[j + 1] - offsets[j], dims);
+        polygon->addRingDirectly(ring);
+      }
+      collection->addGeometryDirectly(polygon);
+    }
+  }
+}
+
 } // namespace node_gdal
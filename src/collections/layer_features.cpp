@@ -3,6 +3,8 @@
 #include "../gdal_feature.hpp"
 #include "../gdal_layer.hpp"
 
+#include <algorithm>
+
 namespace node_gdal {
 
 Nan::Persistent<FunctionTemplate> LayerFeatures::constructor;
@@ -15,12 +17,13 @@ void LayerFeatures::Initialize(Local<Object> target) {
   lcons->SetClassName(Nan::New("LayerFeatures").ToLocalChecked());
 
   Nan::SetPrototypeMethod(lcons, "toString", toString);
-  Nan::SetPrototypeMethod(lcons, "count", count);
+  SET_ASYNCABLE_METHOD(lcons, "count", count);
   Nan::SetPrototypeMethod(lcons, "add", add);
-  Nan::SetPrototypeMethod(lcons, "get", get);
+  SET_ASYNCABLE_METHOD(lcons, "get", get);
   Nan::SetPrototypeMethod(lcons, "set", set);
-  Nan::SetPrototypeMethod(lcons, "first", first);
-  Nan::SetPrototypeMethod(lcons, "next", next);
+  SET_ASYNCABLE_METHOD(lcons, "first", first);
+  SET_ASYNCABLE_METHOD(lcons, "next", next);
+  SET_ASYNCABLE_METHOD(lcons, "readBatch", readBatch);
   Nan::SetPrototypeMethod(lcons, "remove", remove);
 
   ATTR_DONT_ENUM(lcons, "layer", layerGetter, READ_ONLY_SETTER);
@@ -91,7 +94,22 @@ NAN_METHOD(LayerFeatures::toString) {
  * @param {Integer} id The feature ID of the feature to read.
  * @return {gdal.Feature}
  */
-NAN_METHOD(LayerFeatures::get) {
+
+/**
+ * Asynchronously fetch a feature by its identifier.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * **Important:** The `id` argument is not an index. In most cases it will be
+ * zero-based, but in some cases it will not. If iterating, it's best to use the
+ * `nextAsync()` method.
+ *
+ * @method getAsync
+ * @param {Integer} id The feature ID of the feature to read.
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<gdal.Feature>}
+ */
+GDAL_ASYNCABLE_DEFINE(LayerFeatures::get) {
   Nan::HandleScope scope;
 
   Local<Object> parent =
@@ -104,9 +122,18 @@ NAN_METHOD(LayerFeatures::get) {
 
   int feature_id;
   NODE_ARG_INT(0, "feature id", feature_id);
-  OGRFeature *feature = layer->get()->GetFeature(feature_id);
 
-  info.GetReturnValue().Set(Feature::New(feature));
+  OGRLayer *gdal_layer = layer->get();
+  AsyncLockRef async_lock = layer->async_lock;
+  GDALAsyncableJob<OGRFeature *> job;
+  job.persist(parent);
+  job.main = [gdal_layer, async_lock, feature_id]() {
+    AsyncLockGuard lock({async_lock});
+    OGRFeature *feature = gdal_layer->GetFeature(feature_id);
+    return feature;
+  };
+  job.rval = [](OGRFeature *feature) { return Feature::New(feature); };
+  job.run(info, async, 1);
 }
 
 /**
@@ -116,7 +143,18 @@ NAN_METHOD(LayerFeatures::get) {
  * @method first
  * @return {gdal.Feature}
  */
-NAN_METHOD(LayerFeatures::first) {
+
+/**
+ * Asynchronously resets the feature pointer used by `next()` and
+ * returns the first feature in the layer.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @method firstAsync
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<gdal.Feature>}
+ */
+GDAL_ASYNCABLE_DEFINE(LayerFeatures::first) {
   Nan::HandleScope scope;
 
   Local<Object> parent =
@@ -127,10 +165,18 @@ NAN_METHOD(LayerFeatures::first) {
     return;
   }
 
-  layer->get()->ResetReading();
-  OGRFeature *feature = layer->get()->GetNextFeature();
-
-  info.GetReturnValue().Set(Feature::New(feature));
+  OGRLayer *gdal_layer = layer->get();
+  AsyncLockRef async_lock = layer->async_lock;
+  GDALAsyncableJob<OGRFeature *> job;
+  job.persist(parent);
+  job.main = [gdal_layer, async_lock]() {
+    AsyncLockGuard lock({async_lock});
+    gdal_layer->ResetReading();
+    OGRFeature *feature = gdal_layer->GetNextFeature();
+    return feature;
+  };
+  job.rval = [](OGRFeature *feature) { return Feature::New(feature); };
+  job.run(info, async, 0);
 }
 
 /**
@@ -143,7 +189,79 @@ NAN_METHOD(LayerFeatures::first) {
  * @method next
  * @return {gdal.Feature}
  */
-NAN_METHOD(LayerFeatures::next) {
+
+/**
+ * Asynchronously returns the next feature in the layer. Returns null if no more features.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @example
+ * ```
+ * while (feature = await layer.features.nextAsync()) { ... }```
+ *
+ * @method nextAsync
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<gdal.Feature>}
+ */
+GDAL_ASYNCABLE_DEFINE(LayerFeatures::next) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(parent);
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object already destroyed");
+    return;
+  }
+
+  OGRLayer *gdal_layer = layer->get();
+  AsyncLockRef async_lock = layer->async_lock;
+  GDALAsyncableJob<OGRFeature *> job;
+  job.persist(parent);
+  job.main = [gdal_layer, async_lock]() {
+    AsyncLockGuard lock({async_lock});
+    OGRFeature *feature = gdal_layer->GetNextFeature();
+    return feature;
+  };
+  job.rval = [](OGRFeature *feature) { return Feature::New(feature); };
+  job.run(info, async, 0);
+}
+
+/**
+ * Returns up to `count` features following the current feature pointer,
+ * advancing it as `next()` would. Returns an empty array if no more features.
+ *
+ * Reading features in batches avoids a round-trip between JS and
+ * the native code for every single feature.
+ *
+ * @example
+ * ```
+ * let batch;
+ * while ((batch = layer.features.readBatch(1000)).length) { ... }```
+ *
+ * @method readBatch
+ * @param {Integer} count maximum number of features to read
+ * @return {gdal.Feature[]}
+ */
+
+/**
+ * Asynchronously returns up to `count` features following the current feature pointer,
+ * advancing it as `nextAsync()` would. Returns an empty array if no more features.
+ * All features are read in a single background operation.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @example
+ * ```
+ * let batch;
+ * while ((batch = await layer.features.readBatchAsync(1000)).length) { ... }```
+ *
+ * @method readBatchAsync
+ * @param {Integer} count maximum number of features to read
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<gdal.Feature[]>}
+ */
+GDAL_ASYNCABLE_DEFINE(LayerFeatures::readBatch) {
   Nan::HandleScope scope;
 
   Local<Object> parent =
@@ -154,9 +272,36 @@ NAN_METHOD(LayerFeatures::next) {
     return;
   }
 
-  OGRFeature *feature = layer->get()->GetNextFeature();
+  int count;
+  NODE_ARG_INT(0, "count", count);
+  if (count <= 0) {
+    Nan::ThrowRangeError("count must be a positive integer");
+    return;
+  }
 
-  info.GetReturnValue().Set(Feature::New(feature));
+  OGRLayer *gdal_layer = layer->get();
+  AsyncLockRef async_lock = layer->async_lock;
+  GDALAsyncableJob<std::vector<OGRFeature *>> job;
+  job.persist(parent);
+  job.main = [gdal_layer, async_lock, count]() {
+    std::vector<OGRFeature *> features;
+    // count is only an upper bound
+    features.reserve(std::min(count, 1024));
+    AsyncLockGuard lock({async_lock});
+    for (int i = 0; i < count; i++) {
+      OGRFeature *feature = gdal_layer->GetNextFeature();
+      if (feature == nullptr) break;
+      features.push_back(feature);
+    }
+    return features;
+  };
+  job.rval = [](std::vector<OGRFeature *> features) -> Local<Value> {
+    Nan::EscapableHandleScope scope;
+    Local<Array> results = Nan::New<Array>(features.size());
+    for (uint32_t i = 0; i < features.size(); i++) Nan::Set(results, i, Feature::New(features[i]));
+    return scope.Escape(results);
+  };
+  job.run(info, async, 1);
 }
 
 /**
@@ -188,7 +333,9 @@ NAN_METHOD(LayerFeatures::add) {
   Feature *f;
   NODE_ARG_WRAPPED(0, "feature", Feature, f)
 
+  layer->async_lock->lock();
   int err = layer->get()->CreateFeature(f->get());
+  layer->async_lock->unlock();
   if (err) {
     NODE_THROW_OGRERR(err);
     return;
@@ -203,7 +350,19 @@ NAN_METHOD(LayerFeatures::add) {
  * @param {Boolean} [force=true]
  * @return {Integer} Number of features in the layer.
  */
-NAN_METHOD(LayerFeatures::count) {
+
+/**
+ * Asynchronously returns the number of features in the layer.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @method countAsync
+ * @param {Boolean} [force=true]
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
+ * certain optional parameters are omitted
+ * @return {Promise<Integer>} Number of features in the layer.
+ */
+GDAL_ASYNCABLE_DEFINE(LayerFeatures::count) {
   Nan::HandleScope scope;
 
   Local<Object> parent =
@@ -217,7 +376,17 @@ NAN_METHOD(LayerFeatures::count) {
   int force = 1;
   NODE_ARG_BOOL_OPT(0, "force", force);
 
-  info.GetReturnValue().Set(Nan::New<Number>(layer->get()->GetFeatureCount(force)));
+  OGRLayer *gdal_layer = layer->get();
+  AsyncLockRef async_lock = layer->async_lock;
+  GDALAsyncableJob<GIntBig> job;
+  job.persist(parent);
+  job.main = [gdal_layer, async_lock, force]() {
+    AsyncLockGuard lock({async_lock});
+    GIntBig count = gdal_layer->GetFeatureCount(force);
+    return count;
+  };
+  job.rval = [](GIntBig count) -> Local<Value> { return Nan::New<Number>(count); };
+  job.run(info, async, 1);
 }
 
 /**
@@ -263,7 +432,9 @@ NAN_METHOD(LayerFeatures::set) {
     Nan::ThrowError("Feature already destroyed");
     return;
   }
+  layer->async_lock->lock();
   err = layer->get()->SetFeature(f->get());
+  layer->async_lock->unlock();
   if (err) {
     NODE_THROW_OGRERR(err);
     return;
@@ -291,7 +462,9 @@ NAN_METHOD(LayerFeatures::remove) {
 
   int i;
   NODE_ARG_INT(0, "feature id", i);
+  layer->async_lock->lock();
   int err = layer->get()->DeleteFeature(i);
+  layer->async_lock->unlock();
   if (err) {
     NODE_THROW_OGRERR(err);
     return;
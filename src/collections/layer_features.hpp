@@ -11,6 +11,8 @@
 // gdal
 #include <gdal_priv.h>
 
+#include "../async/async_worker.hpp"
+
 using namespace v8;
 using namespace node;
 
@@ -25,10 +27,11 @@ class LayerFeatures : public Nan::ObjectWrap {
   static Local<Value> New(Local<Value> layer_obj);
   static NAN_METHOD(toString);
 
-  static NAN_METHOD(get);
-  static NAN_METHOD(first);
-  static NAN_METHOD(next);
-  static NAN_METHOD(count);
+  GDAL_ASYNCABLE_DECLARE(get);
+  GDAL_ASYNCABLE_DECLARE(first);
+  GDAL_ASYNCABLE_DECLARE(next);
+  GDAL_ASYNCABLE_DECLARE(readBatch);
+  GDAL_ASYNCABLE_DECLARE(count);
   static NAN_METHOD(add);
   static NAN_METHOD(set);
   static NAN_METHOD(remove);
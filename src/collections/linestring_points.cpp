@@ -3,6 +3,7 @@
 #include "../gdal_geometry.hpp"
 #include "../gdal_linestring.hpp"
 #include "../gdal_point.hpp"
+#include "../utils/coordinates.hpp"
 
 namespace node_gdal {
 
@@ -22,6 +23,8 @@ void LineStringPoints::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "add", add);
   Nan::SetPrototypeMethod(lcons, "reverse", reverse);
   Nan::SetPrototypeMethod(lcons, "resize", resize);
+  Nan::SetPrototypeMethod(lcons, "toTypedArray", toTypedArray);
+  Nan::SetPrototypeMethod(lcons, "setFromTypedArray", setFromTypedArray);
 
   Nan::Set(target, Nan::New("LineStringPoints").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
 
@@ -366,4 +369,78 @@ NAN_METHOD(LineStringPoints::add) {
   return;
 }
 
+/**
+ * Returns all the points as a single array of interleaved coordinates,
+ * without creating a {{#crossLink "gdal.Point"}}Point{{/crossLink}} for each
+ * of them.
+ *
+ * @example
+ * ```
+ * const xy = lineString.points.toTypedArray({ dims: 2 });
+ * // [x0, y0, x1, y1, ...]```
+ *
+ * @method toTypedArray
+ * @param {Object} [options]
+ * @param {Integer} [options.dims] `2` (x, y) or `3` (x, y, z), defaults to the
+ * coordinate dimension of the line string
+ * @return {Float64Array}
+ */
+NAN_METHOD(LineStringPoints::toTypedArray) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  LineString *geom = Nan::ObjectWrap::Unwrap<LineString>(parent);
+
+  int dims = geom->get()->getCoordinateDimension() == 3 ? 3 : 2;
+  Local<Object> options;
+  NODE_ARG_OBJECT_OPT(0, "options", options);
+  if (!options.IsEmpty()) NODE_INT_FROM_OBJ_OPT(options, "dims", dims);
+  if (dims != 2 && dims != 3) {
+    Nan::ThrowRangeError("dims must be 2 or 3");
+    return;
+  }
+
+  Local<Value> coordinates;
+  if (!Coordinates::Export(geom->get(), dims, &coordinates, nullptr, nullptr)) return;
+  info.GetReturnValue().Set(coordinates);
+}
+
+/**
+ * Replaces all the points with the interleaved coordinates of an array.
+ *
+ * @example
+ * ```
+ * lineString.points.setFromTypedArray(new Float64Array([0, 0, 10, 10]), 2);```
+ *
+ * @method setFromTypedArray
+ * @throws Error
+ * @param {Float64Array} coordinates
+ * @param {Integer} [dims=2] `2` (x, y) or `3` (x, y, z)
+ */
+NAN_METHOD(LineStringPoints::setFromTypedArray) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  LineString *geom = Nan::ObjectWrap::Unwrap<LineString>(parent);
+
+  int dims = 2;
+  NODE_ARG_INT_OPT(1, "dims", dims);
+  if (dims != 2 && dims != 3) {
+    Nan::ThrowRangeError("dims must be 2 or 3");
+    return;
+  }
+
+  if (info.Length() < 1) {
+    Nan::ThrowError("coordinates must be given");
+    return;
+  }
+  const double *coords;
+  int count;
+  if (!Coordinates::ValidateCoordinates(info[0], dims, coords, count)) return;
+
+  Coordinates::SetCurve(geom->get(), coords, count, dims);
+}
+
 } // namespace node_gdal
@@ -33,6 +33,8 @@ class LineStringPoints : public Nan::ObjectWrap {
   static NAN_METHOD(count);
   static NAN_METHOD(reverse);
   static NAN_METHOD(resize);
+  static NAN_METHOD(toTypedArray);
+  static NAN_METHOD(setFromTypedArray);
 
   LineStringPoints();
 
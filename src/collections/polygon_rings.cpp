@@ -3,6 +3,7 @@
 #include "../gdal_geometry.hpp"
 #include "../gdal_linearring.hpp"
 #include "../gdal_polygon.hpp"
+#include "../utils/coordinates.hpp"
 
 namespace node_gdal {
 
@@ -19,6 +20,8 @@ void PolygonRings::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "count", count);
   Nan::SetPrototypeMethod(lcons, "get", get);
   Nan::SetPrototypeMethod(lcons, "add", add);
+  Nan::SetPrototypeMethod(lcons, "toTypedArray", toTypedArray);
+  Nan::SetPrototypeMethod(lcons, "setFromTypedArray", setFromTypedArray);
 
   Nan::Set(target, Nan::New("PolygonRings").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
 
@@ -184,4 +187,93 @@ NAN_METHOD(PolygonRings::add) {
   return;
 }
 
+/**
+ * Returns the points of all the rings as a single array of interleaved
+ * coordinates. `offsets[i]` is the index of the first point of ring `i`,
+ * the last element is the total number of points.
+ *
+ * @example
+ * ```
+ * const { coordinates, offsets } = polygon.rings.toTypedArray();
+ * const exterior = coordinates.subarray(offsets[0] * 2, offsets[1] * 2);```
+ *
+ * @method toTypedArray
+ * @param {Object} [options]
+ * @param {Integer} [options.dims] `2` (x, y) or `3` (x, y, z), defaults to the
+ * coordinate dimension of the polygon
+ * @return {Object} `{coordinates: Float64Array, offsets: Int32Array}`
+ */
+NAN_METHOD(PolygonRings::toTypedArray) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Polygon *geom = Nan::ObjectWrap::Unwrap<Polygon>(parent);
+
+  int dims = geom->get()->getCoordinateDimension() == 3 ? 3 : 2;
+  Local<Object> options;
+  NODE_ARG_OBJECT_OPT(0, "options", options);
+  if (!options.IsEmpty()) NODE_INT_FROM_OBJ_OPT(options, "dims", dims);
+  if (dims != 2 && dims != 3) {
+    Nan::ThrowRangeError("dims must be 2 or 3");
+    return;
+  }
+
+  Local<Value> coordinates, offsets;
+  if (!Coordinates::Export(geom->get(), dims, &coordinates, &offsets, nullptr)) return;
+
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, Nan::New("coordinates").ToLocalChecked(), coordinates);
+  Nan::Set(result, Nan::New("offsets").ToLocalChecked(), offsets);
+  info.GetReturnValue().Set(result);
+}
+
+/**
+ * Replaces all the rings, the first one being the exterior ring.
+ *
+ * @example
+ * ```
+ * polygon.rings.setFromTypedArray(
+ *   new Float64Array([0, 0, 10, 0, 10, 10, 0, 0]),
+ *   new Int32Array([0, 4]));```
+ *
+ * @method setFromTypedArray
+ * @throws Error
+ * @param {Float64Array} coordinates interleaved coordinates of all the rings
+ * @param {Int32Array} offsets index of the first point of each ring, followed by the total number of points
+ * @param {Integer} [dims=2] `2` (x, y) or `3` (x, y, z)
+ */
+NAN_METHOD(PolygonRings::setFromTypedArray) {
+  Nan::HandleScope scope;
+
+  Local<Object> parent =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Polygon *geom = Nan::ObjectWrap::Unwrap<Polygon>(parent);
+
+  if (info.Length() < 2) {
+    Nan::ThrowError("coordinates and offsets must be given");
+    return;
+  }
+  int dims = 2;
+  NODE_ARG_INT_OPT(2, "dims", dims);
+  if (dims != 2 && dims != 3) {
+    Nan::ThrowRangeError("dims must be 2 or 3");
+    return;
+  }
+
+  const double *coords;
+  const int32_t *offsets;
+  int points, rings;
+  if (!Coordinates::ValidateCoordinates(info[0], dims, coords, points)) return;
+  if (!Coordinates::ValidateOffsets(info[1], "offsets", points, offsets, rings)) return;
+
+  OGRPolygon *polygon = geom->get();
+  polygon->empty();
+  for (int i = 0; i < rings; i++) {
+    OGRLinearRing *ring = new OGRLinearRing();
+    Coordinates::SetCurve(ring, coords + static_cast<size_t>(offsets[i]) * dims, offsets[i + 1] - offsets[i], dims);
+    polygon->addRingDirectly(ring);
+  }
+}
+
 } // namespace node_gdal
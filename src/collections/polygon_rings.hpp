@@ -31,6 +31,8 @@ class PolygonRings : public Nan::ObjectWrap {
   static NAN_METHOD(count);
   static NAN_METHOD(add);
   static NAN_METHOD(remove);
+  static NAN_METHOD(toTypedArray);
+  static NAN_METHOD(setFromTypedArray);
 
   PolygonRings();
 
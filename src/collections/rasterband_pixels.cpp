@@ -2,6 +2,8 @@
 #include "../gdal_common.hpp"
 #include "../gdal_rasterband.hpp"
 #include "../async/async_rasterio.hpp"
+#include "../utils/pinned_block.hpp"
+#include "../utils/rasterio_window.hpp"
 #include "../utils/typed_array.hpp"
 
 #include <sstream>
@@ -26,6 +28,8 @@ void RasterBandPixels::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "writeAsync", writeAsync);
   Nan::SetPrototypeMethod(lcons, "readBlock", readBlock);
   Nan::SetPrototypeMethod(lcons, "writeBlock", writeBlock);
+  Nan::SetPrototypeMethod(lcons, "pinBlock", pinBlock);
+  Nan::SetPrototypeMethod(lcons, "unpinBlock", unpinBlock);
 
   Nan::Set(target, Nan::New("RasterBandPixels").ToLocalChecked(), Nan::GetFunction(lcons).ToLocalChecked());
 
@@ -123,9 +127,9 @@ NAN_METHOD(RasterBandPixels::get) {
   NODE_ARG_INT(0, "x", x);
   NODE_ARG_INT(1, "y", y);
 
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   CPLErr err = band->get()->RasterIO(GF_Read, x, y, 1, 1, &val, 1, 1, GDT_Float64, 0, 0);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   if (err) {
     NODE_THROW_CPLERR(err);
     return;
@@ -155,9 +159,9 @@ NAN_METHOD(RasterBandPixels::set) {
   NODE_ARG_INT(1, "y", y);
   NODE_ARG_DOUBLE(2, "val", val);
 
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   CPLErr err = band->get()->RasterIO(GF_Write, x, y, 1, 1, &val, 1, 1, GDT_Float64, 0, 0);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   if (err) {
     NODE_THROW_CPLERR(err);
     return;
@@ -175,6 +179,7 @@ void RasterBandPixels::_do_read(const Nan::FunctionCallbackInfo<v8::Value> &info
   RasterBand *band;
   if ((band = parent(info)) == nullptr) return;
 
+  RasterIOWindow window;
   int x, y, w, h;
   int buffer_w, buffer_h;
   int bytes_per_pixel;
@@ -185,10 +190,11 @@ void RasterBandPixels::_do_read(const Nan::FunctionCallbackInfo<v8::Value> &info
   Local<Object> obj;
   GDALDataType type;
 
-  NODE_ARG_INT(0, "x_offset", x);
-  NODE_ARG_INT(1, "y_offset", y);
-  NODE_ARG_INT(2, "x_size", w);
-  NODE_ARG_INT(3, "y_size", h);
+  if (window.parse(info, 0, 10)) return; // error parsing window
+  x = window.x;
+  y = window.y;
+  w = window.w;
+  h = window.h;
 
   std::string type_name = "";
 
@@ -202,10 +208,13 @@ void RasterBandPixels::_do_read(const Nan::FunctionCallbackInfo<v8::Value> &info
 
   if (!info[4]->IsUndefined() && !info[4]->IsNull()) {
     NODE_ARG_OBJECT(4, "data", obj);
-    type = TypedArray::Identify(obj);
-    if (type == GDT_Unknown) {
-      Nan::ThrowError("Invalid array");
-      return;
+    // raw memory is filled with data_type, GDAL converts from the band type
+    if (!TypedArray::IsRawMemory(obj)) {
+      type = TypedArray::Identify(obj);
+      if (type == GDT_Unknown) {
+        Nan::ThrowError("Invalid array");
+        return;
+      }
     }
   }
 
@@ -246,13 +255,43 @@ void RasterBandPixels::_do_read(const Nan::FunctionCallbackInfo<v8::Value> &info
 
   if (async) {
     Nan::Callback *callback;
-    NODE_ARG_CB(10, "callback", callback);
-    Nan::AsyncQueueWorker(new AsyncRasterIO(
-      callback, band, GF_Read, x, y, w, h, &obj, data, buffer_w, buffer_h, type, pixel_space, line_space));
+    NODE_ARG_CB(13, "callback", callback);
+    AsyncProgress *progress;
+    if (!AsyncProgress::parse(info, 11, progress)) {
+      delete callback;
+      return;
+    }
+    AsyncRasterIO *job = new AsyncRasterIO(
+      callback, band, GF_Read, x, y, w, h, &obj, data, buffer_w, buffer_h, type, pixel_space, line_space, progress);
+#if GDAL_VERSION_MAJOR >= 2
+    job->setWindow(window);
+#endif
+    thread_pool.queue(job);
   } else {
-    uv_mutex_lock(band->async_lock);
-    CPLErr err = band->get()->RasterIO(GF_Read, x, y, w, h, data, buffer_w, buffer_h, type, pixel_space, line_space);
-    uv_mutex_unlock(band->async_lock);
+#if GDAL_VERSION_MAJOR >= 2
+    GDALRasterIOExtraArg sExtraArg;
+    INIT_RASTERIO_EXTRA_ARG(sExtraArg);
+    window.apply(&sExtraArg);
+#endif
+    band->async_lock->lock();
+    CPLErr err = band->get()->RasterIO(
+      GF_Read,
+      x,
+      y,
+      w,
+      h,
+      data,
+      buffer_w,
+      buffer_h,
+      type,
+      pixel_space,
+      line_space
+#if GDAL_VERSION_MAJOR >= 2
+      ,
+      &sExtraArg
+#endif
+    );
+    band->async_lock->unlock();
     if (err) {
       NODE_THROW_CPLERR(err);
       return;
@@ -266,20 +305,24 @@ void RasterBandPixels::_do_read(const Nan::FunctionCallbackInfo<v8::Value> &info
  *
  * @method read
  * @throws Error
- * @param {Integer} x
- * @param {Integer} y
- * @param {Integer} width
- * @param {Integer} height
- * @param {TypedArray} [data] The
+ * @param {Number} x
+ * @param {Number} y
+ * @param {Number} width
+ * @param {Number} height
+ * @param {TypedArray|DataView|ArrayBuffer|SharedArrayBuffer} [data] The
  * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
- * to put the data in. A new array is created if not given.
+ * (or Buffer) to put the data in, its type selects the data type. A `DataView`,
+ * `ArrayBuffer` or `SharedArrayBuffer` is filled with values of `options.type`.
+ * A new array is created if not given.
  * @param {Object} [options]
  * @param {Integer} [options.buffer_width=x_size]
  * @param {Integer} [options.buffer_height=y_size]
- * @param {String} [options.data_type] See {{#crossLink "Constants (GDT)"}}GDT
- * constants{{/crossLink}}.
+ * @param {String} [options.type] See {{#crossLink "Constants (GDT)"}}GDT
+ * constants{{/crossLink}}, the band data type by default.
  * @param {Integer} [options.pixel_space]
  * @param {Integer} [options.line_space]
+ * @param {String} [options.resampling=nearest] Resampling used when the buffer size differs from the window size:
+ * `nearest`, `bilinear`, `cubic`, `cubicspline`, `lanczos`, `average`, `mode` or `gauss`
  * @return {TypedArray} A
  * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
  * of values.
@@ -295,20 +338,26 @@ NAN_METHOD(RasterBandPixels::read) {
  * as it is the last parameter. Otherwise the function returns a Promise resolved with the result.
  *
  * @method readAsync
- * @param {Integer} x
- * @param {Integer} y
- * @param {Integer} width
- * @param {Integer} height
- * @param {TypedArray} [data] The
+ * @param {Number} x
+ * @param {Number} y
+ * @param {Number} width
+ * @param {Number} height
+ * @param {TypedArray|DataView|ArrayBuffer|SharedArrayBuffer} [data] The
  * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
- * to put the data in. A new array is created if not given.
+ * (or Buffer) to put the data in, its type selects the data type. A `DataView`,
+ * `ArrayBuffer` or `SharedArrayBuffer` is filled with values of `options.type`.
+ * A new array is created if not given.
  * @param {Object} [options]
  * @param {Integer} [options.buffer_width=x_size]
  * @param {Integer} [options.buffer_height=y_size]
- * @param {String} [options.data_type] See {{#crossLink "Constants (GDT)"}}GDT
- * constants{{/crossLink}}.
+ * @param {String} [options.type] See {{#crossLink "Constants (GDT)"}}GDT
+ * constants{{/crossLink}}, the band data type by default.
  * @param {Integer} [options.pixel_space]
  * @param {Integer} [options.line_space]
+ * @param {String} [options.resampling=nearest] Resampling used when the buffer size differs from the window size:
+ * `nearest`, `bilinear`, `cubic`, `cubicspline`, `lanczos`, `average`, `mode` or `gauss`
+ * @param {Function} [options.progress_cb] progress callback, called with the completion ratio
+ * @param {AbortSignal} [options.signal] aborts the operation
  * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
  * certain optional parameters are omitted
  * @return {TypedArray} A
@@ -348,17 +397,25 @@ void RasterBandPixels::_do_write(const Nan::FunctionCallbackInfo<v8::Value> &inf
   NODE_ARG_INT_OPT(5, "buffer_width", buffer_w);
   NODE_ARG_INT_OPT(6, "buffer_height", buffer_h);
 
-  type = TypedArray::Identify(passed_array);
-  if (type == GDT_Unknown) {
-    Nan::ThrowError("Invalid array");
-    return;
+  // raw memory holds data_type (the band type by default), GDAL converts to the band type
+  if (TypedArray::IsRawMemory(passed_array)) {
+    std::string type_name = "";
+    type = band->get()->GetRasterDataType();
+    NODE_ARG_OPT_STR(7, "data_type", type_name);
+    if (!type_name.empty()) { type = GDALGetDataTypeByName(type_name.c_str()); }
+  } else {
+    type = TypedArray::Identify(passed_array);
+    if (type == GDT_Unknown) {
+      Nan::ThrowError("Invalid array");
+      return;
+    }
   }
 
   bytes_per_pixel = GDALGetDataTypeSize(type) / 8;
   pixel_space = bytes_per_pixel;
-  NODE_ARG_INT_OPT(7, "pixel_space", pixel_space);
+  NODE_ARG_INT_OPT(8, "pixel_space", pixel_space);
   line_space = pixel_space * buffer_w;
-  NODE_ARG_INT_OPT(8, "line_space", line_space);
+  NODE_ARG_INT_OPT(9, "line_space", line_space);
 
   size = line_space * buffer_h;                      // bytes
   min_size = size - (pixel_space - bytes_per_pixel); // subtract away padding on last pixel that wont be read
@@ -380,13 +437,32 @@ void RasterBandPixels::_do_write(const Nan::FunctionCallbackInfo<v8::Value> &inf
 
   if (async) {
     Nan::Callback *callback;
-    NODE_ARG_CB(9, "callback", callback);
-    Nan::AsyncQueueWorker(new AsyncRasterIO(
-      callback, band, GF_Read, x, y, w, h, &passed_array, data, buffer_w, buffer_h, type, pixel_space, line_space));
+    NODE_ARG_CB(12, "callback", callback);
+    AsyncProgress *progress;
+    if (!AsyncProgress::parse(info, 10, progress)) {
+      delete callback;
+      return;
+    }
+    thread_pool.queue(new AsyncRasterIO(
+      callback,
+      band,
+      GF_Write,
+      x,
+      y,
+      w,
+      h,
+      &passed_array,
+      data,
+      buffer_w,
+      buffer_h,
+      type,
+      pixel_space,
+      line_space,
+      progress));
   } else {
-    uv_mutex_lock(band->async_lock);
+    band->async_lock->lock();
     CPLErr err = band->get()->RasterIO(GF_Write, x, y, w, h, data, buffer_w, buffer_h, type, pixel_space, line_space);
-    uv_mutex_unlock(band->async_lock);
+    band->async_lock->unlock();
     if (err) {
       NODE_THROW_CPLERR(err);
       return;
@@ -405,12 +481,15 @@ void RasterBandPixels::_do_write(const Nan::FunctionCallbackInfo<v8::Value> &inf
  * @param {Integer} y
  * @param {Integer} width
  * @param {Integer} height
- * @param {TypedArray} data The
+ * @param {TypedArray|DataView|ArrayBuffer|SharedArrayBuffer} data The
  * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
- * to write to the band.
+ * (or Buffer) to write to the band. A `DataView`, `ArrayBuffer` or
+ * `SharedArrayBuffer` holds values of `options.type`.
  * @param {Object} [options]
  * @param {Integer} [options.buffer_width=x_size]
  * @param {Integer} [options.buffer_height=y_size]
+ * @param {String} [options.type] Data type of a `DataView`, `ArrayBuffer` or
+ * `SharedArrayBuffer`, the band data type by default.
  * @param {Integer} [options.pixel_space]
  * @param {Integer} [options.line_space]
  */
@@ -430,14 +509,19 @@ NAN_METHOD(RasterBandPixels::write) {
  * @param {Integer} y
  * @param {Integer} width
  * @param {Integer} height
- * @param {TypedArray} data The
+ * @param {TypedArray|DataView|ArrayBuffer|SharedArrayBuffer} data The
  * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
- * to write to the band.
+ * (or Buffer) to write to the band. A `DataView`, `ArrayBuffer` or
+ * `SharedArrayBuffer` holds values of `options.type`.
  * @param {Object} [options]
  * @param {Integer} [options.buffer_width=x_size]
  * @param {Integer} [options.buffer_height=y_size]
+ * @param {String} [options.type] Data type of a `DataView`, `ArrayBuffer` or
+ * `SharedArrayBuffer`, the band data type by default.
  * @param {Integer} [options.pixel_space]
  * @param {Integer} [options.line_space]
+ * @param {Function} [options.progress_cb] progress callback, called with the completion ratio
+ * @param {AbortSignal} [options.signal] aborts the operation
  * @param {requestCallback} [callback] Promisifiable callback, always the last parameter, can be specified even if
  * certain optional parameters are omitted
  */
@@ -492,9 +576,9 @@ NAN_METHOD(RasterBandPixels::readBlock) {
     return; // TypedArray::Validate threw an error
   }
 
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   CPLErr err = band->get()->ReadBlock(x, y, data);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   if (err) {
     NODE_THROW_CPLERR(err);
     return;
@@ -503,6 +587,78 @@ NAN_METHOD(RasterBandPixels::readBlock) {
   info.GetReturnValue().Set(array);
 }
 
+/**
+ * Returns a block of pixels without copying it.
+ *
+ * The returned array is backed by the block in the GDAL block cache, which
+ * stays locked in the cache until the array is garbage collected or released
+ * with {{#crossLink "gdal.RasterBandPixels/unpinBlock:method"}}unpinBlock(){{/crossLink}}.
+ * Flushing or closing the dataset releases all its pinned blocks, their arrays
+ * become empty.
+ *
+ * The array must not be modified. Writing to the band invalidates its pinned
+ * blocks: the array is not guaranteed to reflect the writes, the block has to
+ * be pinned again once they are done.
+ *
+ * ```
+ * const block = band.pixels.pinBlock(0, 0);
+ * res.end(Buffer.from(block.buffer));
+ * band.pixels.unpinBlock(block);```
+ *
+ * @method pinBlock
+ * @throws Error
+ * @param {Integer} x
+ * @param {Integer} y
+ * @return {TypedArray} A
+ * [TypedArray](https://developer.mozilla.org/en-US/docs/Web/API/ArrayBufferView#Typed_array_subclasses)
+ * of values.
+ */
+NAN_METHOD(RasterBandPixels::pinBlock) {
+  Nan::HandleScope scope;
+
+  RasterBand *band;
+  if ((band = parent(info)) == nullptr) return;
+
+  int x, y;
+  NODE_ARG_INT(0, "block_x_offset", x);
+  NODE_ARG_INT(1, "block_y_offset", y);
+
+  band->async_lock->lock();
+  GDALRasterBlock *block = band->get()->GetLockedBlockRef(x, y);
+  band->async_lock->unlock();
+  if (block == nullptr) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+
+  Local<Object> band_obj =
+    Nan::GetPrivate(info.This(), Nan::New("parent_").ToLocalChecked()).ToLocalChecked().As<Object>();
+  Local<Object> array = PinnedBlock::New(band_obj, band->getParent(), block);
+  if (array.IsEmpty()) return; // PinnedBlock::New threw an error
+
+  info.GetReturnValue().Set(array);
+}
+
+/**
+ * Releases a block returned by {{#crossLink "gdal.RasterBandPixels/pinBlock:method"}}pinBlock(){{/crossLink}}
+ * without waiting for the garbage collector, the array becomes empty.
+ *
+ * @method unpinBlock
+ * @throws Error
+ * @param {TypedArray} data
+ */
+NAN_METHOD(RasterBandPixels::unpinBlock) {
+  Nan::HandleScope scope;
+
+  Local<Object> array;
+  NODE_ARG_OBJECT(0, "data", array);
+
+  if (!PinnedBlock::release(array)) {
+    Nan::ThrowError("Array is not a pinned block");
+    return;
+  }
+}
+
 /**
  * Writes a block of pixels.
  *
@@ -536,9 +692,9 @@ NAN_METHOD(RasterBandPixels::writeBlock) {
     return; // TypedArray::Validate threw an error
   }
 
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   CPLErr err = band->get()->WriteBlock(x, y, data);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
 
   if (err) {
     NODE_THROW_CPLERR(err);
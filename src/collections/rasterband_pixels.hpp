@@ -35,6 +35,8 @@ class RasterBandPixels : public Nan::ObjectWrap {
   static NAN_METHOD(writeAsync);
   static NAN_METHOD(readBlock);
   static NAN_METHOD(writeBlock);
+  static NAN_METHOD(pinBlock);
+  static NAN_METHOD(unpinBlock);
 
   static void _do_read(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async);
   static void _do_write(const Nan::FunctionCallbackInfo<v8::Value> &info, bool async);
@@ -71,19 +71,35 @@ static void _do_open(const Nan::FunctionCallbackInfo<v8::Value> &info, bool asyn
     return;
   }
 
+  Local<Object> options;
+  int pool_size = 0;
+  NODE_ARG_OBJECT_OPT(2, "options", options);
+  if (!options.IsEmpty()) { NODE_INT_FROM_OBJ_OPT(options, "pool", pool_size); }
+  if (pool_size < 0) {
+    Nan::ThrowRangeError("pool must be a positive integer");
+    return;
+  }
+  if (pool_size > 0 && mode != "r") {
+    Nan::ThrowError("Only datasets opened in \"r\" mode can be pooled");
+    return;
+  }
+
+  DatasetPoolRef pool;
+  if (pool_size > 0) pool = std::make_shared<DatasetPool>(path, flags, pool_size);
+
   std::function<GDALDataset *()> doit = [path, flags]() {
     return (GDALDataset *)GDALOpenEx(path.c_str(), flags, NULL, NULL, NULL);
   };
 
   if (async) {
     Nan::Callback *callback;
-    NODE_ARG_CB(2, "callback", callback);
-    Nan::AsyncQueueWorker(new AsyncOpen(callback, doit));
+    NODE_ARG_CB(3, "callback", callback);
+    thread_pool.queue(new AsyncOpen(callback, doit, pool));
     return;
   } else {
     GDALDataset *ds = doit();
     if (ds) {
-      info.GetReturnValue().Set(Dataset::New(ds));
+      info.GetReturnValue().Set(Dataset::New(ds, pool));
       return;
     }
   }
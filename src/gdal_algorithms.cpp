@@ -1,4 +1,5 @@
 #include "gdal_algorithms.hpp"
+#include "async/async_lock.hpp"
 #include "gdal_common.hpp"
 #include "gdal_dataset.hpp"
 #include "gdal_layer.hpp"
@@ -9,10 +10,15 @@ namespace node_gdal {
 
 void Algorithms::Initialize(Local<Object> target) {
   Nan::SetMethod(target, "fillNodata", fillNodata);
+  Nan::SetMethod(target, "fillNodataAsync", fillNodataAsync);
   Nan::SetMethod(target, "contourGenerate", contourGenerate);
+  Nan::SetMethod(target, "contourGenerateAsync", contourGenerateAsync);
   Nan::SetMethod(target, "sieveFilter", sieveFilter);
+  Nan::SetMethod(target, "sieveFilterAsync", sieveFilterAsync);
   Nan::SetMethod(target, "checksumImage", checksumImage);
+  Nan::SetMethod(target, "checksumImageAsync", checksumImageAsync);
   Nan::SetMethod(target, "polygonize", polygonize);
+  Nan::SetMethod(target, "polygonizeAsync", polygonizeAsync);
 }
 
 /**
@@ -31,7 +37,30 @@ void Algorithms::Initialize(Local<Object> target) {
  * filter smoothing iterations to run after the interpolation to dampen
  * artifacts.
  */
-NAN_METHOD(Algorithms::fillNodata) {
+
+/**
+ * Asynchronously fill raster regions by interpolation from edges.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @throws Error
+ * @method fillNodataAsync
+ * @static
+ * @for gdal
+ * @param {Object} options
+ * @param {gdal.RasterBand} options.src This band to be updated in-place.
+ * @param {gdal.RasterBand} [options.mask] Mask band
+ * @param {Number} options.searchDist The maximum distance (in pixels) that the
+ * algorithm will search out for values to interpolate.
+ * @param {integer} [options.smoothingIterations=0] The number of 3x3 average
+ * filter smoothing iterations to run after the interpolation to dampen
+ * artifacts.
+ * @param {Function} [options.progress_cb] Progress callback, called with the completion ratio
+ * @param {AbortSignal} [options.signal] Aborts the operation
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Algorithms::fillNodata) {
   Nan::HandleScope scope;
 
   Local<Object> obj;
@@ -47,15 +76,32 @@ NAN_METHOD(Algorithms::fillNodata) {
   NODE_DOUBLE_FROM_OBJ(obj, "searchDist", search_dist);
   NODE_INT_FROM_OBJ_OPT(obj, "smoothIterations", smooth_iterations)
 
-  CPLErr err =
-    GDALFillNodata(src->get(), mask ? mask->get() : NULL, search_dist, 0, smooth_iterations, NULL, NULL, NULL);
-
-  if (err) {
-    NODE_THROW_CPLERR(err);
-    return;
-  }
-
-  return;
+  GDALAsyncableJob<CPLErr> job;
+  if (async && !AsyncProgress::parse(info, 1, job.progress)) return;
+  job.persist(src->handle());
+  if (mask) job.persist(mask->handle());
+
+  GDALRasterBand *gdal_src = src->get();
+  GDALRasterBand *gdal_mask = mask ? mask->get() : NULL;
+  AsyncLockRef src_lock = src->async_lock;
+  AsyncLockRef mask_lock = mask ? mask->async_lock : nullptr;
+  AsyncProgress *progress = job.progress;
+  job.main = [gdal_src, gdal_mask, src_lock, mask_lock, search_dist, smooth_iterations, progress]() {
+    AsyncLockGuard lock({src_lock, mask_lock});
+    CPLErr err = GDALFillNodata(
+      gdal_src,
+      gdal_mask,
+      search_dist,
+      0,
+      smooth_iterations,
+      NULL,
+      progress ? AsyncProgress::progress : NULL,
+      progress);
+    if (err != CE_None) throw CPLGetLastErrorMsg();
+    return err;
+  };
+  job.rval = [](CPLErr) -> Local<Value> { return Nan::Undefined(); };
+  job.run(info, async, 3);
 }
 
 /**
@@ -88,7 +134,36 @@ NAN_METHOD(Algorithms::fillNodata) {
  * @param {integer} [options.elevField] A field index to indicate where the
  * elevation value of the contour should be written.
  */
-NAN_METHOD(Algorithms::contourGenerate) {
+
+/**
+ * Asynchronously create vector contours from raster DEM.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @throws Error
+ * @method contourGenerateAsync
+ * @static
+ * @for gdal
+ * @param {Object} options
+ * @param {gdal.RasterBand} options.src
+ * @param {gdal.Layer} options.dst
+ * @param {Number} [options.offset=0] The "offset" relative to which contour
+ * intervals are applied.
+ * @param {Number} [options.interval=100] The elevation interval between
+ * contours generated.
+ * @param {Number[]} [options.fixedLevels] A list of fixed contour levels at
+ * which contours should be generated. Overrides interval/base options if set.
+ * @param {Number} [options.nodata] The value to use as a "nodata" value.
+ * @param {integer} [options.idField] A field index to indicate where a unique
+ * id should be written for each feature (contour) written.
+ * @param {integer} [options.elevField] A field index to indicate where the
+ * elevation value of the contour should be written.
+ * @param {Function} [options.progress_cb] Progress callback, called with the completion ratio
+ * @param {AbortSignal} [options.signal] Aborts the operation
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Algorithms::contourGenerate) {
   Nan::HandleScope scope;
 
   Local<Object> obj;
@@ -96,9 +171,8 @@ NAN_METHOD(Algorithms::contourGenerate) {
   RasterBand *src;
   Layer *dst;
   double interval = 100, base = 0;
-  double *fixed_levels = NULL;
   DoubleList fixed_level_array;
-  int n_fixed_levels = 0;
+  std::vector<double> fixed_levels;
   int use_nodata = 0;
   double nodata = 0;
   int id_field = -1, elev_field = -1;
@@ -115,8 +189,7 @@ NAN_METHOD(Algorithms::contourGenerate) {
     if (fixed_level_array.parse(Nan::Get(obj, Nan::New("fixedLevels").ToLocalChecked()).ToLocalChecked())) {
       return; // error parsing double list
     } else {
-      fixed_levels = fixed_level_array.get();
-      n_fixed_levels = fixed_level_array.length();
+      fixed_levels.assign(fixed_level_array.get(), fixed_level_array.get() + fixed_level_array.length());
     }
   }
   if (Nan::HasOwnProperty(obj, Nan::New("nodata").ToLocalChecked()).FromMaybe(false)) {
@@ -126,29 +199,51 @@ NAN_METHOD(Algorithms::contourGenerate) {
       nodata = Nan::To<double>(prop).ToChecked();
     } else if (!prop->IsNull() && !prop->IsUndefined()) {
       Nan::ThrowTypeError("nodata property must be a number");
+      return;
     }
   }
 
-  CPLErr err = GDALContourGenerate(
-    src->get(),
-    interval,
-    base,
-    n_fixed_levels,
-    fixed_levels,
-    use_nodata,
-    nodata,
-    dst->get(),
-    id_field,
-    elev_field,
-    NULL,
-    NULL);
-
-  if (err) {
-    NODE_THROW_CPLERR(err);
-    return;
-  }
-
-  return;
+  GDALAsyncableJob<CPLErr> job;
+  if (async && !AsyncProgress::parse(info, 1, job.progress)) return;
+  job.persist(src->handle());
+  job.persist(dst->handle());
+
+  GDALRasterBand *gdal_src = src->get();
+  OGRLayer *gdal_dst = dst->get();
+  AsyncLockRef src_lock = src->async_lock;
+  AsyncLockRef dst_lock = dst->async_lock;
+  AsyncProgress *progress = job.progress;
+  job.main = [gdal_src,
+              gdal_dst,
+              src_lock,
+              dst_lock,
+              interval,
+              base,
+              fixed_levels,
+              use_nodata,
+              nodata,
+              id_field,
+              elev_field,
+              progress]() {
+    AsyncLockGuard lock({src_lock, dst_lock});
+    CPLErr err = GDALContourGenerate(
+      gdal_src,
+      interval,
+      base,
+      fixed_levels.size(),
+      const_cast<double *>(fixed_levels.data()),
+      use_nodata,
+      nodata,
+      gdal_dst,
+      id_field,
+      elev_field,
+      progress ? AsyncProgress::progress : NULL,
+      progress);
+    if (err != CE_None) throw CPLGetLastErrorMsg();
+    return err;
+  };
+  job.rval = [](CPLErr) -> Local<Value> { return Nan::Undefined(); };
+  job.run(info, async, 3);
 }
 
 /**
@@ -170,7 +265,31 @@ NAN_METHOD(Algorithms::contourGenerate) {
  * pixels are not considered directly adjacent for polygon membership purposes
  * or 8 indicating they are.
  */
-NAN_METHOD(Algorithms::sieveFilter) {
+
+/**
+ * Asynchronously removes small raster polygons.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @throws Error
+ * @method sieveFilterAsync
+ * @static
+ * @for gdal
+ * @param {Object} options
+ * @param {gdal.RasterBand} options.src
+ * @param {gdal.RasterBand} options.dst Output raster band. It may be the same
+ * as src band to update the source in place.
+ * @param {gdal.RasterBand} [options.mask] All pixels in the mask band with a
+ * value other than zero will be considered suitable for inclusion in polygons.
+ * @param {Number} options.threshold Raster polygons with sizes smaller than
+ * this will be merged into their largest neighbour.
+ * @param {integer} [options.connectedness=4] Either 4 or 8.
+ * @param {Function} [options.progress_cb] Progress callback, called with the completion ratio
+ * @param {AbortSignal} [options.signal] Aborts the operation
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Algorithms::sieveFilter) {
   Nan::HandleScope scope;
 
   Local<Object> obj;
@@ -193,15 +312,36 @@ NAN_METHOD(Algorithms::sieveFilter) {
     return;
   }
 
-  CPLErr err =
-    GDALSieveFilter(src->get(), mask ? mask->get() : NULL, dst->get(), threshold, connectedness, NULL, NULL, NULL);
-
-  if (err) {
-    NODE_THROW_CPLERR(err);
-    return;
-  }
-
-  return;
+  GDALAsyncableJob<CPLErr> job;
+  if (async && !AsyncProgress::parse(info, 1, job.progress)) return;
+  job.persist(src->handle());
+  job.persist(dst->handle());
+  if (mask) job.persist(mask->handle());
+
+  GDALRasterBand *gdal_src = src->get();
+  GDALRasterBand *gdal_dst = dst->get();
+  GDALRasterBand *gdal_mask = mask ? mask->get() : NULL;
+  AsyncLockRef src_lock = src->async_lock;
+  AsyncLockRef dst_lock = dst->async_lock;
+  AsyncLockRef mask_lock = mask ? mask->async_lock : nullptr;
+  AsyncProgress *progress = job.progress;
+  job.main =
+    [gdal_src, gdal_dst, gdal_mask, src_lock, dst_lock, mask_lock, threshold, connectedness, progress]() {
+      AsyncLockGuard lock({src_lock, dst_lock, mask_lock});
+      CPLErr err = GDALSieveFilter(
+        gdal_src,
+        gdal_mask,
+        gdal_dst,
+        threshold,
+        connectedness,
+        NULL,
+        progress ? AsyncProgress::progress : NULL,
+        progress);
+      if (err != CE_None) throw CPLGetLastErrorMsg();
+      return err;
+    };
+  job.rval = [](CPLErr) -> Local<Value> { return Nan::Undefined(); };
+  job.run(info, async, 3);
 }
 
 /**
@@ -218,7 +358,25 @@ NAN_METHOD(Algorithms::sieveFilter) {
  * @param {integer} [h=src.height]
  * @return integer
  */
-NAN_METHOD(Algorithms::checksumImage) {
+
+/**
+ * Asynchronously compute checksum for image region.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @throws Error
+ * @method checksumImageAsync
+ * @static
+ * @for gdal
+ * @param {gdal.RasterBand} src
+ * @param {integer} [x=0]
+ * @param {integer} [y=0]
+ * @param {integer} [w=src.width]
+ * @param {integer} [h=src.height]
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<integer>}
+ */
+GDAL_ASYNCABLE_DEFINE(Algorithms::checksumImage) {
   Nan::HandleScope scope;
 
   RasterBand *src;
@@ -247,9 +405,20 @@ NAN_METHOD(Algorithms::checksumImage) {
     return;
   }
 
-  int checksum = GDALChecksumImage(src->get(), x, y, w, h);
-
-  info.GetReturnValue().Set(Nan::New<Integer>(checksum));
+  GDALAsyncableJob<int> job;
+  job.persist(src->handle());
+
+  GDALRasterBand *gdal_src = src->get();
+  AsyncLockRef async_lock = src->async_lock;
+  job.main = [gdal_src, async_lock, x, y, w, h]() {
+    AsyncLockGuard lock({async_lock});
+    CPLErrorReset();
+    int checksum = GDALChecksumImage(gdal_src, x, y, w, h);
+    if (CPLGetLastErrorType() == CE_Failure) throw CPLGetLastErrorMsg();
+    return checksum;
+  };
+  job.rval = [](int checksum) -> Local<Value> { return Nan::New<Integer>(checksum); };
+  job.run(info, async, 5);
 }
 
 /**
@@ -275,7 +444,33 @@ NAN_METHOD(Algorithms::checksumImage) {
  * @param {Boolean} [options.useFloats=false] Use floating point buffers instead
  * of int buffers.
  */
-NAN_METHOD(Algorithms::polygonize) {
+
+/**
+ * Asynchronously creates vector polygons for all connected regions of pixels
+ * in the raster sharing a common pixel value.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @throws Error
+ * @method polygonizeAsync
+ * @static
+ * @for gdal
+ * @param {Object} options
+ * @param {gdal.RasterBand} options.src
+ * @param {gdal.Layer} options.dst
+ * @param {gdal.RasterBand} [options.mask]
+ * @param {integer} options.pixValField The attribute field index indicating the
+ * feature attribute into which the pixel value of the polygon should be
+ * written.
+ * @param {integer} [options.connectedness=4] Either 4 or 8.
+ * @param {Boolean} [options.useFloats=false] Use floating point buffers instead
+ * of int buffers.
+ * @param {Function} [options.progress_cb] Progress callback, called with the completion ratio
+ * @param {AbortSignal} [options.signal] Aborts the operation
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Algorithms::polygonize) {
   Nan::HandleScope scope;
 
   Local<Object> obj;
@@ -284,7 +479,7 @@ NAN_METHOD(Algorithms::polygonize) {
   Layer *dst;
   int connectedness = 4;
   int pix_val_field = 0;
-  char **papszOptions = NULL;
+  bool use_floats = false;
 
   NODE_ARG_OBJECT(0, "options", obj);
 
@@ -294,44 +489,71 @@ NAN_METHOD(Algorithms::polygonize) {
   NODE_INT_FROM_OBJ_OPT(obj, "connectedness", connectedness)
   NODE_INT_FROM_OBJ(obj, "pixValField", pix_val_field);
 
-  if (connectedness == 8) {
-    papszOptions = CSLSetNameValue(papszOptions, "8CONNECTED", "8");
-  } else if (connectedness != 4) {
+  if (connectedness != 4 && connectedness != 8) {
     Nan::ThrowError("connectedness must be 4 or 8");
     return;
   }
 
-  CPLErr err;
   if (
     Nan::HasOwnProperty(obj, Nan::New("useFloats").ToLocalChecked()).FromMaybe(false) &&
     Nan::To<bool>(Nan::Get(obj, Nan::New("useFloats").ToLocalChecked()).ToLocalChecked()).ToChecked()) {
-    err = GDALFPolygonize(
-      src->get(),
-      mask ? mask->get() : NULL,
-      reinterpret_cast<OGRLayerH>(dst->get()),
-      pix_val_field,
-      papszOptions,
-      NULL,
-      NULL);
-  } else {
-    err = GDALPolygonize(
-      src->get(),
-      mask ? mask->get() : NULL,
-      reinterpret_cast<OGRLayerH>(dst->get()),
-      pix_val_field,
-      papszOptions,
-      NULL,
-      NULL);
+    use_floats = true;
   }
 
-  if (papszOptions) CSLDestroy(papszOptions);
-
-  if (err) {
-    NODE_THROW_CPLERR(err);
-    return;
-  }
+  GDALAsyncableJob<CPLErr> job;
+  if (async && !AsyncProgress::parse(info, 1, job.progress)) return;
+  job.persist(src->handle());
+  job.persist(dst->handle());
+  if (mask) job.persist(mask->handle());
+
+  GDALRasterBandH gdal_src = src->get();
+  GDALRasterBandH gdal_mask = mask ? mask->get() : NULL;
+  OGRLayerH gdal_dst = reinterpret_cast<OGRLayerH>(dst->get());
+  AsyncLockRef src_lock = src->async_lock;
+  AsyncLockRef dst_lock = dst->async_lock;
+  AsyncLockRef mask_lock = mask ? mask->async_lock : nullptr;
+  AsyncProgress *progress = job.progress;
+  job.main = [gdal_src,
+              gdal_mask,
+              gdal_dst,
+              src_lock,
+              dst_lock,
+              mask_lock,
+              pix_val_field,
+              connectedness,
+              use_floats,
+              progress]() {
+    char **papszOptions = NULL;
+    if (connectedness == 8) papszOptions = CSLSetNameValue(papszOptions, "8CONNECTED", "8");
+
+    AsyncLockGuard lock({src_lock, dst_lock, mask_lock});
+    CPLErr err;
+    if (use_floats) {
+      err = GDALFPolygonize(
+        gdal_src,
+        gdal_mask,
+        gdal_dst,
+        pix_val_field,
+        papszOptions,
+        progress ? AsyncProgress::progress : NULL,
+        progress);
+    } else {
+      err = GDALPolygonize(
+        gdal_src,
+        gdal_mask,
+        gdal_dst,
+        pix_val_field,
+        papszOptions,
+        progress ? AsyncProgress::progress : NULL,
+        progress);
+    }
 
-  return;
+    if (papszOptions) CSLDestroy(papszOptions);
+    if (err != CE_None) throw CPLGetLastErrorMsg();
+    return err;
+  };
+  job.rval = [](CPLErr) -> Local<Value> { return Nan::Undefined(); };
+  job.run(info, async, 3);
 }
 
 } // namespace node_gdal
@@ -406,6 +406,16 @@ NAN_SETTER(READ_ONLY_SETTER);
     }                                                                                                                  \
   }
 
+#define NODE_ARG_OBJECT_OPT(num, name, var)                                                                            \
+  if (info.Length() > num) {                                                                                           \
+    if (info[num]->IsObject()) {                                                                                       \
+      var = info[num].As<Object>();                                                                                    \
+    } else if (!info[num]->IsNull() && !info[num]->IsUndefined()) {                                                    \
+      Nan::ThrowTypeError(name " must be an object");                                                                  \
+      return;                                                                                                          \
+    }                                                                                                                  \
+  }
+
 // ----- wrapped methods w/ results-------
 
 #define NODE_WRAPPED_METHOD_WITH_NO_RESULT(klass, method, wrapped_method)                                              \
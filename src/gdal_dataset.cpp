@@ -1,6 +1,7 @@
 #include "gdal_dataset.hpp"
 #include "collections/dataset_bands.hpp"
 #include "collections/dataset_layers.hpp"
+#include "collections/dataset_pixels.hpp"
 #include "gdal_common.hpp"
 #include "gdal_driver.hpp"
 #include "gdal_geometry.hpp"
@@ -8,6 +9,7 @@
 #include "gdal_majorobject.hpp"
 #include "gdal_rasterband.hpp"
 #include "gdal_spatial_reference.hpp"
+#include "utils/pinned_block.hpp"
 
 namespace node_gdal {
 
@@ -33,12 +35,13 @@ void Dataset::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "close", close);
   Nan::SetPrototypeMethod(lcons, "getMetadata", getMetadata);
   Nan::SetPrototypeMethod(lcons, "testCapability", testCapability);
-  Nan::SetPrototypeMethod(lcons, "executeSQL", executeSQL);
-  Nan::SetPrototypeMethod(lcons, "buildOverviews", buildOverviews);
+  SET_ASYNCABLE_METHOD(lcons, "executeSQL", executeSQL);
+  SET_ASYNCABLE_METHOD(lcons, "buildOverviews", buildOverviews);
 
   ATTR_DONT_ENUM(lcons, "_uid", uidGetter, READ_ONLY_SETTER);
   ATTR(lcons, "description", descriptionGetter, READ_ONLY_SETTER);
   ATTR(lcons, "bands", bandsGetter, READ_ONLY_SETTER);
+  ATTR(lcons, "pixels", pixelsGetter, READ_ONLY_SETTER);
   ATTR(lcons, "layers", layersGetter, READ_ONLY_SETTER);
   ATTR(lcons, "rasterSize", rasterSizeGetter, READ_ONLY_SETTER);
   ATTR(lcons, "driver", driverGetter, READ_ONLY_SETTER);
@@ -127,6 +130,9 @@ NAN_METHOD(Dataset::New) {
     Local<Value> layers = DatasetLayers::New(info.This());
     Nan::SetPrivate(info.This(), Nan::New("layers_").ToLocalChecked(), layers);
 
+    Local<Value> pixels = DatasetPixels::New(info.This());
+    Nan::SetPrivate(info.This(), Nan::New("pixels_").ToLocalChecked(), pixels);
+
     info.GetReturnValue().Set(info.This());
     return;
   } else {
@@ -135,7 +141,7 @@ NAN_METHOD(Dataset::New) {
   }
 }
 
-Local<Value> Dataset::New(GDALDataset *raw) {
+Local<Value> Dataset::New(GDALDataset *raw, DatasetPoolRef pool) {
   Nan::EscapableHandleScope scope;
 
   if (!raw) { return scope.Escape(Nan::Null()); }
@@ -152,10 +158,10 @@ Local<Value> Dataset::New(GDALDataset *raw) {
   /* The async locks must live outside the V8 memory management,
    * otherwise they won't be accessible from the async threads
    */
-  wrapped->async_lock = new uv_mutex_t;
-  uv_mutex_init(wrapped->async_lock);
+  wrapped->async_lock = std::make_shared<AsyncLock>();
 
-  wrapped->uid = ptr_manager.add(raw, wrapped->async_lock);
+  wrapped->pool = pool;
+  wrapped->uid = ptr_manager.add(raw, wrapped->async_lock, pool);
 
   return scope.Escape(obj);
 }
@@ -174,8 +180,7 @@ Local<Value> Dataset::New(OGRDataSource *raw) {
     Nan::NewInstance(Nan::GetFunction(Nan::New(Dataset::constructor)).ToLocalChecked(), 1, &ext).ToLocalChecked();
 
   datasource_cache.add(raw, obj);
-  wrapped->async_lock = new uv_mutex_t;
-  uv_mutex_init(wrapped->async_lock);
+  wrapped->async_lock = std::make_shared<AsyncLock>();
   wrapped->uid = ptr_manager.add(raw);
 
   return scope.Escape(obj);
@@ -213,9 +218,9 @@ NAN_METHOD(Dataset::getMetadata) {
   GDALDataset *raw = ds->getDataset();
   std::string domain("");
   NODE_ARG_OPT_STR(0, "domain", domain);
-  uv_mutex_lock(ds->async_lock);
+  ds->async_lock->lock();
   info.GetReturnValue().Set(MajorObject::getMetadata(raw, domain.empty() ? NULL : domain.c_str()));
-  uv_mutex_unlock(ds->async_lock);
+  ds->async_lock->unlock();
 }
 
 /**
@@ -248,9 +253,9 @@ NAN_METHOD(Dataset::testCapability) {
   std::string capability("");
   NODE_ARG_STR(0, "capability", capability);
 
-  uv_mutex_lock(ds->async_lock);
+  ds->async_lock->lock();
   info.GetReturnValue().Set(Nan::New<Boolean>(raw->TestCapability(capability.c_str())));
-  uv_mutex_unlock(ds->async_lock);
+  ds->async_lock->unlock();
 }
 
 /**
@@ -276,9 +281,9 @@ NAN_METHOD(Dataset::getGCPProjection) {
 #endif
 
   GDALDataset *raw = ds->getDataset();
-  uv_mutex_lock(ds->async_lock);
+  ds->async_lock->lock();
   info.GetReturnValue().Set(SafeString::New(raw->GetGCPProjection()));
-  uv_mutex_unlock(ds->async_lock);
+  ds->async_lock->unlock();
 }
 
 /**
@@ -294,6 +299,7 @@ NAN_METHOD(Dataset::close) {
     return;
   }
 
+  if (ds->getDataset()) PinnedBlock::releaseAll(ds->getDataset());
   ds->dispose();
 
   return;
@@ -331,9 +337,10 @@ NAN_METHOD(Dataset::flush) {
     Nan::ThrowError("Dataset object has already been destroyed");
     return;
   }
-  uv_mutex_lock(ds->async_lock);
+  PinnedBlock::releaseAll(raw, true);
+  ds->async_lock->lock();
   raw->FlushCache();
-  uv_mutex_unlock(ds->async_lock);
+  ds->async_lock->unlock();
 
   return;
 }
@@ -353,7 +360,26 @@ NAN_METHOD(Dataset::flush) {
  * used.
  * @return {gdal.Layer}
  */
-NAN_METHOD(Dataset::executeSQL) {
+
+/**
+ * Asynchronously execute an SQL statement against the data store.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * The query is planned and run on a worker thread. The resulting layer is
+ * a result set that is released when the dataset is closed, its features can
+ * be read without blocking with the asynchronous iterator.
+ *
+ * @throws Error
+ * @method executeSQLAsync
+ * @param {String} statement SQL statement to execute.
+ * @param {gdal.Geometry} [spatial_filter=null] Geometry which represents a
+ * spatial filter.
+ * @param {String} [dialect=null] Allows control of the statement dialect.
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<gdal.Layer>}
+ */
+GDAL_ASYNCABLE_DEFINE(Dataset::executeSQL) {
   Nan::HandleScope scope;
   Dataset *ds = Nan::ObjectWrap::Unwrap<Dataset>(info.This());
 
@@ -380,19 +406,32 @@ NAN_METHOD(Dataset::executeSQL) {
   NODE_ARG_WRAPPED_OPT(1, "spatial filter geometry", Geometry, spatial_filter);
   NODE_ARG_OPT_STR(2, "sql dialect", sql_dialect);
 
-  uv_mutex_lock(ds->async_lock);
-  OGRLayer *layer = raw->ExecuteSQL(
-    sql.c_str(), spatial_filter ? spatial_filter->get() : NULL, sql_dialect.empty() ? NULL : sql_dialect.c_str());
-
-  if (layer) {
-    info.GetReturnValue().Set(Layer::New(layer, raw, true));
-    uv_mutex_unlock(ds->async_lock);
-    return;
-  } else {
-    uv_mutex_unlock(ds->async_lock);
-    Nan::ThrowError("Error executing SQL");
-    return;
-  }
+  GDALAsyncableJob<OGRLayer *> job;
+  job.persist(info.This());
+  if (spatial_filter) job.persist(spatial_filter->handle());
+
+  OGRGeometry *filter = spatial_filter ? spatial_filter->get() : NULL;
+  AsyncLockRef async_lock = ds->async_lock;
+  long uid = ds->uid;
+  // released by ptr_manager if the dataset is closed before the layer is created
+  std::shared_ptr<OGRLayer *> result_set = std::make_shared<OGRLayer *>(nullptr);
+  ptr_manager.addPendingResultSet(result_set, uid);
+  job.main = [raw, async_lock, result_set, sql, filter, sql_dialect]() {
+    AsyncLockGuard lock({async_lock});
+    OGRLayer *layer = raw->ExecuteSQL(sql.c_str(), filter, sql_dialect.empty() ? NULL : sql_dialect.c_str());
+    if (layer == nullptr) throw "Error executing SQL";
+    *result_set = layer;
+    return layer;
+  };
+  job.rval = [raw, uid, result_set](OGRLayer *) -> Local<Value> {
+    // the dataset was closed before the result set could be registered,
+    // ptr_manager has released it
+    if (!ptr_manager.isAlive(uid)) throw "Dataset object has already been destroyed";
+    OGRLayer *layer = *result_set;
+    *result_set = nullptr;
+    return Layer::New(layer, raw, true);
+  };
+  job.run(info, async, 3);
 }
 
 /**
@@ -431,11 +470,11 @@ NAN_METHOD(Dataset::getFileList) {
     return;
   }
 
-  uv_mutex_lock(ds->async_lock);
+  ds->async_lock->lock();
   char **list = raw->GetFileList();
   if (!list) {
     info.GetReturnValue().Set(results);
-    uv_mutex_unlock(ds->async_lock);
+    ds->async_lock->unlock();
     return;
   }
 
@@ -444,7 +483,7 @@ NAN_METHOD(Dataset::getFileList) {
     Nan::Set(results, i, SafeString::New(list[i]));
     i++;
   }
-  uv_mutex_unlock(ds->async_lock);
+  ds->async_lock->unlock();
 
   CSLDestroy(list);
 
@@ -481,13 +520,13 @@ NAN_METHOD(Dataset::getGCPs) {
     return;
   }
 
-  uv_mutex_lock(ds->async_lock);
+  ds->async_lock->lock();
   int n = raw->GetGCPCount();
   const GDAL_GCP *gcps = raw->GetGCPs();
 
   if (!gcps) {
     info.GetReturnValue().Set(results);
-    uv_mutex_unlock(ds->async_lock);
+    ds->async_lock->unlock();
     return;
   }
 
@@ -505,7 +544,7 @@ NAN_METHOD(Dataset::getGCPs) {
   }
 
   info.GetReturnValue().Set(results);
-  uv_mutex_unlock(ds->async_lock);
+  ds->async_lock->unlock();
 }
 
 /**
@@ -574,9 +613,9 @@ NAN_METHOD(Dataset::setGCPs) {
     gcp++;
   }
 
-  uv_mutex_lock(ds->async_lock);
+  ds->async_lock->lock();
   CPLErr err = raw->SetGCPs(gcps->Length(), list, projection.c_str());
-  uv_mutex_unlock(ds->async_lock);
+  ds->async_lock->unlock();
 
   if (list) {
     delete[] list;
@@ -602,8 +641,32 @@ NAN_METHOD(Dataset::setGCPs) {
  * @param {Integer[]} overviews
  * @param {Integer[]} [bands] Note: Generation of overviews in external TIFF
  * currently only supported when operating on all bands.
+ * @param {Object} [options]
+ * @param {Integer|string} [options.threads] Number of threads used to compute
+ * the overviews or `"ALL_CPUS"`, sets `GDAL_NUM_THREADS` for this operation
  */
-NAN_METHOD(Dataset::buildOverviews) {
+
+/**
+ * Asynchronously builds dataset overviews.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @throws Error
+ * @method buildOverviewsAsync
+ * @param {String} resampling `"NEAREST"`, `"GAUSS"`, `"CUBIC"`, `"AVERAGE"`,
+ * `"MODE"`, `"AVERAGE_MAGPHASE"` or `"NONE"`
+ * @param {Integer[]} overviews
+ * @param {Integer[]} [bands] Note: Generation of overviews in external TIFF
+ * currently only supported when operating on all bands.
+ * @param {Object} [options]
+ * @param {Integer|string} [options.threads] Number of threads used to compute
+ * the overviews or `"ALL_CPUS"`, sets `GDAL_NUM_THREADS` for this operation
+ * @param {Function} [options.progress_cb] Progress callback, called with the completion ratio
+ * @param {AbortSignal} [options.signal] Aborts the operation
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Dataset::buildOverviews) {
   Nan::HandleScope scope;
   Dataset *ds = Nan::ObjectWrap::Unwrap<Dataset>(info.This());
 
@@ -623,63 +686,85 @@ NAN_METHOD(Dataset::buildOverviews) {
   std::string resampling = "";
   Local<Array> overviews;
   Local<Array> bands;
+  Local<Object> options;
+  std::string threads;
 
   NODE_ARG_STR(0, "resampling", resampling);
   NODE_ARG_ARRAY(1, "overviews", overviews);
   NODE_ARG_ARRAY_OPT(2, "bands", bands);
+  NODE_ARG_OBJECT_OPT(3, "options", options);
+
+  if (!options.IsEmpty() && Nan::HasOwnProperty(options, Nan::New("threads").ToLocalChecked()).FromMaybe(false)) {
+    Local<Value> prop = Nan::Get(options, Nan::New("threads").ToLocalChecked()).ToLocalChecked();
+    if (prop->IsNumber() && Nan::To<int32_t>(prop).ToChecked() > 0) {
+      threads = std::to_string(Nan::To<int32_t>(prop).ToChecked());
+    } else if (prop->IsString() && std::string(*Nan::Utf8String(prop)) == "ALL_CPUS") {
+      threads = "ALL_CPUS";
+    } else if (!prop->IsUndefined() && !prop->IsNull()) {
+      Nan::ThrowTypeError("threads must be a positive integer or \"ALL_CPUS\"");
+      return;
+    }
+  }
 
-  int *o, *b = NULL;
+  std::shared_ptr<std::vector<int>> o(new std::vector<int>());
+  std::shared_ptr<std::vector<int>> b(new std::vector<int>());
   int n_overviews = overviews->Length();
   int i, n_bands = 0;
 
-  o = new int[n_overviews];
   for (i = 0; i < n_overviews; i++) {
     Local<Value> val = Nan::Get(overviews, i).ToLocalChecked();
     if (!val->IsNumber()) {
-      delete[] o;
       Nan::ThrowError("overviews array must only contain numbers");
       return;
     }
-    o[i] = Nan::To<int32_t>(val).ToChecked();
+    o->push_back(Nan::To<int32_t>(val).ToChecked());
   }
 
-  uv_mutex_lock(ds->async_lock);
   if (!bands.IsEmpty()) {
     n_bands = bands->Length();
-    b = new int[n_bands];
+    ds->async_lock->lock();
+    int n_raster_bands = raw->GetRasterCount();
+    ds->async_lock->unlock();
     for (i = 0; i < n_bands; i++) {
       Local<Value> val = Nan::Get(bands, i).ToLocalChecked();
       if (!val->IsNumber()) {
-        delete[] o;
-        delete[] b;
-        uv_mutex_unlock(ds->async_lock);
         Nan::ThrowError("band array must only contain numbers");
         return;
       }
-      b[i] = Nan::To<int32_t>(val).ToChecked();
-      if (b[i] > raw->GetRasterCount() || b[i] < 1) {
+      int band = Nan::To<int32_t>(val).ToChecked();
+      if (band > n_raster_bands || band < 1) {
         // BuildOverviews prints an error but segfaults before returning
-        delete[] o;
-        delete[] b;
-        uv_mutex_unlock(ds->async_lock);
         Nan::ThrowError("invalid band id");
         return;
       }
+      b->push_back(band);
     }
   }
 
-  CPLErr err = raw->BuildOverviews(resampling.c_str(), n_overviews, o, n_bands, b, NULL, NULL);
-  uv_mutex_unlock(ds->async_lock);
-
-  delete[] o;
-  if (b) delete[] b;
-
-  if (err) {
-    NODE_THROW_CPLERR(err);
-    return;
-  }
-
-  return;
+  GDALAsyncableJob<CPLErr> job;
+  if (async && !AsyncProgress::parse(info, 4, job.progress)) return;
+  job.persist(info.This());
+
+  AsyncLockRef async_lock = ds->async_lock;
+  AsyncProgress *progress = job.progress;
+  job.main = [raw, async_lock, resampling, o, b, threads, progress]() {
+    AsyncLockGuard lock({async_lock});
+    // thread-local, does not affect the other jobs
+    if (!threads.empty()) CPLSetThreadLocalConfigOption("GDAL_NUM_THREADS", threads.c_str());
+    CPLErr err = raw->BuildOverviews(
+      resampling.c_str(),
+      o->size(),
+      o->data(),
+      b->size(),
+      b->empty() ? NULL : b->data(),
+      progress ? AsyncProgress::progress : NULL,
+      progress);
+    if (!threads.empty()) CPLSetThreadLocalConfigOption("GDAL_NUM_THREADS", NULL);
+    if (err != CE_None) throw CPLGetLastErrorMsg();
+    return err;
+  };
+  job.rval = [](CPLErr) -> Local<Value> { return Nan::Undefined(); };
+  job.run(info, async, 6);
 }
 
 /**
@@ -709,9 +794,9 @@ NAN_GETTER(Dataset::descriptionGetter) {
     Nan::ThrowError("Dataset object has already been destroyed");
     return;
   }
-  uv_mutex_lock(ds->async_lock);
+  ds->async_lock->lock();
   info.GetReturnValue().Set(SafeString::New(raw->GetDescription()));
-  uv_mutex_unlock(ds->async_lock);
+  ds->async_lock->unlock();
 }
 
 /**
@@ -742,11 +827,11 @@ NAN_GETTER(Dataset::rasterSizeGetter) {
   // GDAL 2.x will return 512x512 for vector datasets... which doesn't really make
   // sense in JS where we can return null instead of a number
   // https://github.com/OSGeo/gdal/blob/beef45c130cc2778dcc56d85aed1104a9b31f7e6/gdal/gcore/gdaldataset.cpp#L173-L174
-  uv_mutex_lock(ds->async_lock);
+  ds->async_lock->lock();
 #if GDAL_VERSION_MAJOR >= 2
   if (raw->GetDriver() == nullptr || !raw->GetDriver()->GetMetadataItem(GDAL_DCAP_RASTER)) {
     info.GetReturnValue().Set(Nan::Null());
-    uv_mutex_unlock(ds->async_lock);
+    ds->async_lock->unlock();
     return;
   }
 #endif
@@ -755,7 +840,7 @@ NAN_GETTER(Dataset::rasterSizeGetter) {
   Nan::Set(result, Nan::New("x").ToLocalChecked(), Nan::New<Integer>(raw->GetRasterXSize()));
   Nan::Set(result, Nan::New("y").ToLocalChecked(), Nan::New<Integer>(raw->GetRasterYSize()));
   info.GetReturnValue().Set(result);
-  uv_mutex_unlock(ds->async_lock);
+  ds->async_lock->unlock();
 }
 
 /**
@@ -782,11 +867,11 @@ NAN_GETTER(Dataset::srsGetter) {
 #endif
 
   GDALDataset *raw = ds->getDataset();
-  uv_mutex_lock(ds->async_lock);
+  ds->async_lock->lock();
   // get projection wkt and return null if not set
   OGRChar *wkt = (OGRChar *)raw->GetProjectionRef();
   if (*wkt == '\0') {
-    uv_mutex_unlock(ds->async_lock);
+    ds->async_lock->unlock();
     // getProjectionRef returns string of length 0 if no srs set
     info.GetReturnValue().Set(Nan::Null());
     return;
@@ -794,7 +879,7 @@ NAN_GETTER(Dataset::srsGetter) {
   // otherwise construct and return SpatialReference from wkt
   OGRSpatialReference *srs = new OGRSpatialReference();
   int err = srs->importFromWkt(&wkt);
-  uv_mutex_unlock(ds->async_lock);
+  ds->async_lock->unlock();
 
   if (err) {
     NODE_THROW_OGRERR(err);
@@ -835,9 +920,9 @@ NAN_GETTER(Dataset::geoTransformGetter) {
 
   GDALDataset *raw = ds->getDataset();
   double transform[6];
-  uv_mutex_lock(ds->async_lock);
+  ds->async_lock->lock();
   CPLErr err = raw->GetGeoTransform(transform);
-  uv_mutex_unlock(ds->async_lock);
+  ds->async_lock->unlock();
   if (err) {
     // This is mostly (always?) a sign that it has not been set
     info.GetReturnValue().Set(Nan::Null());
@@ -918,9 +1003,9 @@ NAN_SETTER(Dataset::srsSetter) {
     return;
   }
 
-  uv_mutex_lock(ds->async_lock);
+  ds->async_lock->lock();
   CPLErr err = raw->SetProjection(wkt.c_str());
-  uv_mutex_unlock(ds->async_lock);
+  ds->async_lock->unlock();
 
   if (err) { NODE_THROW_CPLERR(err); }
 }
@@ -964,9 +1049,9 @@ NAN_SETTER(Dataset::geoTransformSetter) {
     buffer[i] = Nan::To<double>(val).ToChecked();
   }
 
-  uv_mutex_lock(ds->async_lock);
+  ds->async_lock->lock();
   CPLErr err = raw->SetGeoTransform(buffer);
-  uv_mutex_unlock(ds->async_lock);
+  ds->async_lock->unlock();
 
   if (err) { NODE_THROW_CPLERR(err); }
 }
@@ -981,6 +1066,18 @@ NAN_GETTER(Dataset::bandsGetter) {
   info.GetReturnValue().Set(Nan::GetPrivate(info.This(), Nan::New("bands_").ToLocalChecked()).ToLocalChecked());
 }
 
+/**
+ * The pixels of several bands, read or written at once.
+ *
+ * @readOnly
+ * @attribute pixels
+ * @type {gdal.DatasetPixels}
+ */
+NAN_GETTER(Dataset::pixelsGetter) {
+  Nan::HandleScope scope;
+  info.GetReturnValue().Set(Nan::GetPrivate(info.This(), Nan::New("pixels_").ToLocalChecked()).ToLocalChecked());
+}
+
 /**
  * @readOnly
  * @attribute layers
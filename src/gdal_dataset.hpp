@@ -14,6 +14,9 @@
 // ogr
 #include <ogrsf_frmts.h>
 
+#include "async/async_lock.hpp"
+#include "async/async_worker.hpp"
+#include "utils/dataset_pool.hpp"
 #include "utils/obj_cache.hpp"
 
 using namespace v8;
@@ -30,7 +33,7 @@ class Dataset : public Nan::ObjectWrap {
   static Nan::Persistent<FunctionTemplate> constructor;
   static void Initialize(Local<Object> target);
   static NAN_METHOD(New);
-  static Local<Value> New(GDALDataset *ds);
+  static Local<Value> New(GDALDataset *ds, DatasetPoolRef pool = nullptr);
   static NAN_METHOD(toString);
   static NAN_METHOD(flush);
   static NAN_METHOD(getMetadata);
@@ -38,12 +41,13 @@ class Dataset : public Nan::ObjectWrap {
   static NAN_METHOD(getGCPProjection);
   static NAN_METHOD(getGCPs);
   static NAN_METHOD(setGCPs);
-  static NAN_METHOD(executeSQL);
+  GDAL_ASYNCABLE_DECLARE(executeSQL);
   static NAN_METHOD(testCapability);
-  static NAN_METHOD(buildOverviews);
+  GDAL_ASYNCABLE_DECLARE(buildOverviews);
   static NAN_METHOD(close);
 
   static NAN_GETTER(bandsGetter);
+  static NAN_GETTER(pixelsGetter);
   static NAN_GETTER(rasterSizeGetter);
   static NAN_GETTER(srsGetter);
   static NAN_GETTER(driverGetter);
@@ -82,7 +86,9 @@ class Dataset : public Nan::ObjectWrap {
   }
 #endif
 
-  uv_mutex_t *async_lock;
+  AsyncLockRef async_lock;
+  // only set when opened with the pool option
+  DatasetPoolRef pool;
 
     private:
   ~Dataset();
@@ -2,6 +2,7 @@
 #include "gdal_common.hpp"
 #include "gdal_dataset.hpp"
 #include "gdal_majorobject.hpp"
+#include "gdal_memfile.hpp"
 #include "async/async_open.hpp"
 #include "utils/string_list.hpp"
 
@@ -27,6 +28,7 @@ void Driver::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "createAsync", createAsync);
   Nan::SetPrototypeMethod(lcons, "createCopy", createCopy);
   Nan::SetPrototypeMethod(lcons, "createCopyAsync", createCopyAsync);
+  SET_ASYNCABLE_METHOD(lcons, "createCopyToBuffer", createCopyToBuffer);
   Nan::SetPrototypeMethod(lcons, "deleteDataset", deleteDataset);
   Nan::SetPrototypeMethod(lcons, "rename", rename);
   Nan::SetPrototypeMethod(lcons, "copyFiles", copyFiles);
@@ -267,7 +269,7 @@ void Driver::_do_create(const Nan::FunctionCallbackInfo<v8::Value> &info, bool a
   if (async) {
     Nan::Callback *callback;
     NODE_ARG_CB(6, "callback", callback);
-    Nan::AsyncQueueWorker(new AsyncOpen(callback, doit));
+    thread_pool.queue(new AsyncOpen(callback, doit));
   } else {
     GDALDataset *ds = doit();
     if (!ds) {
@@ -389,21 +391,31 @@ void Driver::_do_create_copy(const Nan::FunctionCallbackInfo<v8::Value> &info, b
   }
 #endif
 
+  AsyncProgress *progress = nullptr;
+  if (async && !AsyncProgress::parse(info, 3, progress)) return;
+  std::unique_ptr<AsyncProgress> progress_ref(progress);
+
   GDALDriver *raw = driver->getGDALDriver();
-  uv_mutex_t *async_lock = src_dataset->async_lock;
-  std::function<GDALDataset *()> doit = [raw, filename, src_dataset, strict, options, async_lock]() {
-    GDALDataset *raw_ds = src_dataset->getDataset();
-    uv_mutex_lock(async_lock);
-    GDALDataset *ds = raw->CreateCopy(filename.c_str(), raw_ds, strict, options->get(), NULL, NULL);
-    uv_mutex_unlock(async_lock);
-    delete options;
+  GDALDataset *raw_ds = src_dataset->getDataset();
+  AsyncLockRef async_lock = src_dataset->async_lock;
+  // freed with the lambda, even if an aborted job never runs it
+  std::shared_ptr<StringList> options_ref(options);
+  std::function<GDALDataset *()> doit = [raw, filename, raw_ds, strict, options_ref, async_lock, progress]() {
+    AsyncLockScope scope(async_lock);
+    async_lock->lock();
+    // the source dataset can be closed while the job is queued
+    GDALDataset *ds = async_lock->closed
+      ? nullptr
+      : raw->CreateCopy(
+          filename.c_str(), raw_ds, strict, options_ref->get(), progress ? AsyncProgress::progress : NULL, progress);
+    async_lock->unlock();
     return ds;
   };
 
   if (async) {
     Nan::Callback *callback;
-    NODE_ARG_CB(3, "callback", callback);
-    Nan::AsyncQueueWorker(new AsyncOpen(callback, doit));
+    NODE_ARG_CB(5, "callback", callback);
+    thread_pool.queue(new AsyncOpen(callback, doit, nullptr, progress_ref.release()));
   } else {
     GDALDataset *ds = doit();
     if (!ds) {
@@ -437,9 +449,9 @@ NAN_METHOD(Driver::createCopy) {
  * @method createCopyAsync
  * @param {String} filename
  * @param {gdal.Dataset} src
- * @param {Boolean} [strict=false]
  * @param {String[]|object} [options=null] An array or object containing
  * driver-specific dataset creation options
+ * @param {JobOptions} [job_options] progress callback and abort signal
  * @param {Callback} callback promisifiable callback
  * @return gdal.Dataset
  */
@@ -447,6 +459,97 @@ NAN_METHOD(Driver::createCopyAsync) {
   _do_create_copy(info, true);
 }
 
+/**
+ * Create a copy of a dataset in memory and return the file content.
+ *
+ * The copy is written to a temporary `/vsimem/` file, which is removed and
+ * returned as a Buffer without copying its data. Only the main file is
+ * returned, the sidecar files of multi-file formats are deleted.
+ *
+ * ```
+ * const png = gdal.drivers.get('PNG').createCopyToBuffer(ds);```
+ *
+ * @throws Error
+ * @method createCopyToBuffer
+ * @param {gdal.Dataset} src
+ * @param {String[]|object} [options=null] An array or object containing
+ * driver-specific dataset creation options
+ * @return {Buffer}
+ */
+
+/**
+ * Asynchronously create a copy of a dataset in memory and return the file content.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @method createCopyToBufferAsync
+ * @param {gdal.Dataset} src
+ * @param {String[]|object} [options=null] An array or object containing
+ * driver-specific dataset creation options
+ * @param {JobOptions} [job_options] progress callback and abort signal
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<Buffer>}
+ */
+GDAL_ASYNCABLE_DEFINE(Driver::createCopyToBuffer) {
+  Nan::HandleScope scope;
+  Driver *driver = Nan::ObjectWrap::Unwrap<Driver>(info.This());
+
+  if (!driver->isAlive()) {
+    Nan::ThrowError("Driver object has already been destroyed");
+    return;
+  }
+
+  Dataset *src_dataset;
+  NODE_ARG_WRAPPED(0, "source dataset", Dataset, src_dataset);
+
+#if GDAL_VERSION_MAJOR < 2
+  if (driver->uses_ogr || src_dataset->uses_ogr) {
+    Nan::ThrowError("Driver unable to copy dataset to a Buffer");
+    return;
+  }
+#endif
+
+  std::shared_ptr<StringList> options(new StringList);
+  if (info.Length() > 1 && options->parse(info[1])) {
+    return; // error parsing string list
+  }
+
+  GDALAsyncableJob<std::pair<GByte *, size_t>> job;
+  if (async && !AsyncProgress::parse(info, 2, job.progress)) return;
+  job.persist(info[0].As<Object>());
+
+  GDALDriver *raw = driver->getGDALDriver();
+  GDALDataset *raw_src = src_dataset->getDataset();
+  AsyncLockRef async_lock = src_dataset->async_lock;
+  AsyncProgress *progress = job.progress;
+
+  // some drivers check the extension
+  std::string dir = Memfile::tempDir();
+  const char *ext = raw->GetMetadataItem(GDAL_DMD_EXTENSION);
+  std::string filename = dir + "/copy" + (ext != nullptr && ext[0] != '\0' ? std::string(".") + ext : "");
+
+  job.main = [raw, raw_src, options, async_lock, progress, dir, filename]() {
+    AsyncLockGuard lock({async_lock});
+    VSIMkdir(dir.c_str(), 0755);
+    GDALDataset *ds = raw->CreateCopy(
+      filename.c_str(), raw_src, FALSE, options->get(), progress ? AsyncProgress::progress : NULL, progress);
+    if (ds == nullptr) {
+      Memfile::unlinkDir(dir);
+      throw "Error copying dataset";
+    }
+    // the file is complete only once closed
+    GDALClose(ds);
+
+    std::pair<GByte *, size_t> r;
+    const char *err = Memfile::take(filename, r.first, r.second);
+    Memfile::unlinkDir(dir);
+    if (err != nullptr) throw err;
+    return r;
+  };
+  job.rval = [](std::pair<GByte *, size_t> r) -> Local<Value> { return Memfile::toBuffer(r.first, r.second); };
+  job.run(info, async, 4);
+}
+
 /**
  * Copy the files of a dataset.
  *
@@ -598,7 +701,7 @@ void Driver::_do_open(const Nan::FunctionCallbackInfo<v8::Value> &info, bool asy
   if (async) {
     Nan::Callback *callback;
     NODE_ARG_CB(2, "callback", callback);
-    Nan::AsyncQueueWorker(new AsyncOpen(callback, doit));
+    thread_pool.queue(new AsyncOpen(callback, doit));
     return;
   }
 
@@ -14,6 +14,7 @@
 // ogr
 #include <ogrsf_frmts.h>
 
+#include "async/async_worker.hpp"
 #include "utils/obj_cache.hpp"
 
 using namespace v8;
@@ -38,6 +39,7 @@ class Driver : public Nan::ObjectWrap {
   static NAN_METHOD(createAsync);
   static NAN_METHOD(createCopy);
   static NAN_METHOD(createCopyAsync);
+  GDAL_ASYNCABLE_DECLARE(createCopyToBuffer);
   static NAN_METHOD(deleteDataset);
   static NAN_METHOD(rename);
   static NAN_METHOD(copyFiles);
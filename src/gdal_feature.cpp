@@ -6,6 +6,7 @@
 #include "gdal_field_defn.hpp"
 #include "gdal_geometry.hpp"
 #include "gdal_layer.hpp"
+#include "utils/geojson.hpp"
 
 namespace node_gdal {
 
@@ -28,6 +29,7 @@ void Feature::Initialize(Local<Object> target) {
   // Nan::SetPrototypeMethod(lcons, "getFieldDefn", getFieldDefn); (use
   // defn.fields.get() instead)
   Nan::SetPrototypeMethod(lcons, "setFrom", setFrom);
+  Nan::SetPrototypeMethod(lcons, "toGeoJSON", toGeoJSON);
 
   // Note: We should let node GC handle destroying features when they arent
   // being used
@@ -187,6 +189,50 @@ NAN_METHOD(Feature::getGeometry) {
   info.GetReturnValue().Set(Geometry::New(geom, false));
 }
 
+/**
+ * Converts the feature to a GeoJSON Feature object, in one pass and
+ * without serializing the geometry to a JSON string.
+ *
+ * @example
+ * ```
+ * const { id, properties, geometry } = feature.toGeoJSON();```
+ *
+ * @method toGeoJSON
+ * @throws Error
+ * @return {Object} `{type: 'Feature', id, properties, geometry}`, `id` is omitted
+ * if the feature has no FID
+ */
+NAN_METHOD(Feature::toGeoJSON) {
+  Nan::HandleScope scope;
+
+  Feature *feature = Nan::ObjectWrap::Unwrap<Feature>(info.This());
+  if (!feature->isAlive()) {
+    Nan::ThrowError("Feature object already destroyed");
+    return;
+  }
+
+  Local<Object> obj = Nan::New<Object>();
+  Nan::Set(obj, Nan::New("type").ToLocalChecked(), Nan::New("Feature").ToLocalChecked());
+
+  GIntBig fid = feature->this_->GetFID();
+  if (fid != OGRNullFID) Nan::Set(obj, Nan::New("id").ToLocalChecked(), Nan::New<Number>(fid));
+
+  Local<Value> properties = FeatureFields::toObject(feature->this_);
+  if (properties.IsEmpty()) return; // toObject threw an error
+  Nan::Set(obj, Nan::New("properties").ToLocalChecked(), properties);
+
+  OGRGeometry *geom = feature->this_->GetGeometryRef();
+  if (geom) {
+    Local<Value> geometry = GeoJSON::FromGeometry(geom);
+    if (geometry.IsEmpty()) return; // FromGeometry threw an error
+    Nan::Set(obj, Nan::New("geometry").ToLocalChecked(), geometry);
+  } else {
+    Nan::Set(obj, Nan::New("geometry").ToLocalChecked(), Nan::Null());
+  }
+
+  info.GetReturnValue().Set(obj);
+}
+
 /**
  * Returns the definition of a particular field at an index.
  *
@@ -32,6 +32,7 @@ class Feature : public Nan::ObjectWrap {
   static NAN_METHOD(equals);
   static NAN_METHOD(getFieldDefn);
   static NAN_METHOD(setFrom);
+  static NAN_METHOD(toGeoJSON);
   static NAN_METHOD(destroy);
 
   static NAN_GETTER(fieldsGetter);
@@ -11,6 +11,7 @@
 #include "gdal_point.hpp"
 #include "gdal_polygon.hpp"
 #include "gdal_spatial_reference.hpp"
+#include "utils/geojson.hpp"
 
 #include <node_buffer.h>
 #include <ogr_core.h>
@@ -39,6 +40,7 @@ void Geometry::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "toKML", exportToKML);
   Nan::SetPrototypeMethod(lcons, "toGML", exportToGML);
   Nan::SetPrototypeMethod(lcons, "toJSON", exportToJSON);
+  Nan::SetPrototypeMethod(lcons, "toObject", toObject);
   Nan::SetPrototypeMethod(lcons, "toWKT", exportToWKT);
   Nan::SetPrototypeMethod(lcons, "toWKB", exportToWKB);
   Nan::SetPrototypeMethod(lcons, "isEmpty", isEmpty);
@@ -690,6 +692,25 @@ NAN_METHOD(Geometry::exportToJSON) {
   return;
 }
 
+/**
+ * Converts the geometry to a GeoJSON object representation.
+ *
+ * The object is built directly from the geometry, without serializing it
+ * to a JSON string first. Curve geometries are linearized.
+ *
+ * @method toObject
+ * @return {Object} GeoJSON
+ */
+NAN_METHOD(Geometry::toObject) {
+  Nan::HandleScope scope;
+
+  Geometry *geom = Nan::ObjectWrap::Unwrap<Geometry>(info.This());
+
+  Local<Value> result = GeoJSON::FromGeometry(geom->this_);
+  if (result.IsEmpty()) return; // FromGeometry threw an error
+  info.GetReturnValue().Set(result);
+}
+
 /**
  * Compute the centroid of the geometry.
  *
@@ -851,37 +872,27 @@ NAN_METHOD(Geometry::createFromWkb) {
 }
 
 /**
- * Creates a Geometry from a GeoJSON string.
+ * Creates a Geometry from a GeoJSON object.
+ *
+ * The object is read directly, without serializing it to a JSON string.
+ * Positions can also be given as `Float64Array`s, and the coordinates of a
+ * LineString or of a ring as a single `Float64Array` of interleaved x, y.
  *
  * @static
  * @method fromGeoJson
+ * @throws Error
  * @param {Object} geojson
  * @return gdal.Geometry
  */
 NAN_METHOD(Geometry::createFromGeoJson) {
   Nan::HandleScope scope;
-#if GDAL_VERSION_MAJOR < 2 || (GDAL_VERSION_MAJOR <= 2 && GDAL_VERSION_MINOR < 3)
-  Nan::ThrowError("GDAL < 2.3 does not support parsing GeoJSON directly");
-  return;
-#else
 
   Local<Object> geo_obj;
   NODE_ARG_OBJECT(0, "geojson", geo_obj);
 
-  // goes to text to pass it in, there isn't a performant way to
-  // go from v8 JSON -> CPLJSON anyways
-  Nan::JSON NanJSON;
-  Nan::MaybeLocal<String> result = NanJSON.Stringify(geo_obj);
-  if (result.IsEmpty()) {
-    Nan::ThrowError("Invalid GeoJSON");
-    return;
-  }
-  Local<String> stringified = result.ToLocalChecked();
-  std::string val = *Nan::Utf8String(stringified);
-
-  OGRGeometry *geom = OGRGeometryFactory::createFromGeoJson(val.c_str());
+  OGRGeometry *geom = GeoJSON::ToGeometry(geo_obj);
+  if (geom == nullptr) return; // ToGeometry threw an error
   info.GetReturnValue().Set(Geometry::New(geom, true));
-#endif
 }
 
 /**
@@ -36,6 +36,7 @@ class Geometry : public Nan::ObjectWrap {
   static NAN_METHOD(exportToKML);
   static NAN_METHOD(exportToGML);
   static NAN_METHOD(exportToJSON);
+  static NAN_METHOD(toObject);
   static NAN_METHOD(exportToWKT);
   static NAN_METHOD(exportToWKB);
   static NAN_METHOD(closeRings);
@@ -1,5 +1,6 @@
 
 #include "gdal_layer.hpp"
+#include "async/async_lock.hpp"
 #include "collections/layer_features.hpp"
 #include "collections/layer_fields.hpp"
 #include "gdal_common.hpp"
@@ -9,6 +10,8 @@
 #include "gdal_field_defn.hpp"
 #include "gdal_geometry.hpp"
 #include "gdal_spatial_reference.hpp"
+#include "utils/geojson.hpp"
+#include "utils/layer_columns.hpp"
 
 #include <sstream>
 #include <stdlib.h>
@@ -32,6 +35,8 @@ void Layer::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "getSpatialFilter", getSpatialFilter);
   Nan::SetPrototypeMethod(lcons, "testCapability", testCapability);
   Nan::SetPrototypeMethod(lcons, "flush", syncToDisk);
+  SET_ASYNCABLE_METHOD(lcons, "readColumns", readColumns);
+  SET_ASYNCABLE_METHOD(lcons, "toGeoJSONString", toGeoJSONString);
 
   ATTR_DONT_ENUM(lcons, "ds", dsGetter, READ_ONLY_SETTER);
   ATTR_DONT_ENUM(lcons, "_uid", uidGetter, READ_ONLY_SETTER);
@@ -48,11 +53,11 @@ void Layer::Initialize(Local<Object> target) {
   constructor.Reset(lcons);
 }
 
-Layer::Layer(OGRLayer *layer) : Nan::ObjectWrap(), uid(0), this_(layer), parent_ds(0) {
+Layer::Layer(OGRLayer *layer) : Nan::ObjectWrap(), uid(0), async_lock(nullptr), this_(layer), parent_ds(0) {
   LOG("Created layer [%p]", layer);
 }
 
-Layer::Layer() : Nan::ObjectWrap(), uid(0), this_(0), parent_ds(0) {
+Layer::Layer() : Nan::ObjectWrap(), uid(0), async_lock(nullptr), this_(0), parent_ds(0) {
 }
 
 Layer::~Layer() {
@@ -154,10 +159,12 @@ Local<Value> Layer::New(OGRLayer *raw, OGRDataSource *raw_parent, bool result_se
     // ds = Dataset::New(raw_parent); //should never happen
   }
 
-  long parent_uid = Nan::ObjectWrap::Unwrap<Dataset>(ds)->uid;
+  Dataset *parent = Nan::ObjectWrap::Unwrap<Dataset>(ds);
+  long parent_uid = parent->uid;
 
   wrapped->uid = ptr_manager.add(raw, parent_uid, result_set);
   wrapped->parent_ds = raw_parent;
+  wrapped->async_lock = parent->async_lock;
   Nan::SetPrivate(obj, Nan::New("ds_").ToLocalChecked(), ds);
 
   return scope.Escape(obj);
@@ -352,6 +359,172 @@ NAN_METHOD(Layer::setAttributeFilter) {
   return;
 }
 
+/**
+ * Reads the features into columns, without creating a `gdal.Feature` for
+ * each row.
+ *
+ * Each field is returned as `{type, values, valid}`, `values` being an
+ * `Int32Array` (integer fields) or a `Float64Array` (real and 64-bit integer
+ * fields). All the other types are read as strings and returned as
+ * `{type, offsets, data, valid}`: the UTF-8 bytes of the string of row `i`
+ * are `data.subarray(offsets[i], offsets[i + 1])`. `valid` is a bitmap, the
+ * value of row `i` is not null if `valid[i >> 3] & (1 << (i & 7))`.
+ *
+ * The geometries are returned as `{wkb, offsets, valid}` (the WKB of row `i`
+ * is `wkb.subarray(offsets[i], offsets[i + 1])`), or as `{xy, offsets, valid}`
+ * with all the vertices of row `i` interleaved from `xy[2 * offsets[i]]`,
+ * the parts of multi-geometries and polygons are not delimited.
+ *
+ * Without `batchSize` the whole layer is read from its first feature,
+ * otherwise the next `batchSize` features are read, `count` is `0` once
+ * all the features have been read.
+ *
+ * ```
+ * const { count, fid, fields, geometry } = layer.readColumns({ fields: [ 'name', 'population' ] });
+ * const population = fields.population.values;```
+ *
+ * @method readColumns
+ * @throws Error
+ * @param {Object} [options]
+ * @param {String[]} [options.fields] Field names, all the fields by default
+ * @param {String} [options.geometry='wkb'] `'wkb'`, `'xy'` or `'none'`
+ * @param {Number} [options.batchSize] Maximum number of features
+ * @return {Object} `{count, fid, fields, geometry}`
+ */
+
+/**
+ * Asynchronously reads the features into columns.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @method readColumnsAsync
+ * @param {Object} [options]
+ * @param {String[]} [options.fields] Field names, all the fields by default
+ * @param {String} [options.geometry='wkb'] `'wkb'`, `'xy'` or `'none'`
+ * @param {Number} [options.batchSize] Maximum number of features
+ * @param {AbortSignal} [options.signal] Allows to abort the operation
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<Object>}
+ */
+GDAL_ASYNCABLE_DEFINE(Layer::readColumns) {
+  Nan::HandleScope scope;
+
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(info.This());
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object has already been destroyed");
+    return;
+  }
+
+  OGRLayer *gdal_layer = layer->this_;
+  std::shared_ptr<LayerColumns> columns = std::make_shared<LayerColumns>();
+  if (columns->parse(info, 0, gdal_layer->GetLayerDefn())) return; // parse threw an error
+
+  int batch_size = 0;
+  NODE_ARG_INT_OPT(2, "batchSize", batch_size);
+  if (info.Length() > 2 && !info[2]->IsUndefined() && !info[2]->IsNull() && batch_size <= 0) {
+    Nan::ThrowRangeError("batchSize must be a positive integer");
+    return;
+  }
+
+  GDALAsyncableJob<std::shared_ptr<LayerColumns>> job;
+  if (async && !AsyncProgress::parse(info, 3, job.progress)) return;
+
+  AsyncLockRef async_lock = layer->async_lock;
+  AsyncProgress *progress = job.progress;
+  job.persist(info.This());
+  job.main = [gdal_layer, async_lock, columns, batch_size, progress]() {
+    AsyncLockGuard lock({async_lock});
+    if (batch_size == 0) gdal_layer->ResetReading();
+    columns->read(gdal_layer, batch_size, progress);
+    return columns;
+  };
+  job.rval = [](std::shared_ptr<LayerColumns> columns) -> Local<Value> { return columns->toObject(); };
+  job.run(info, async, 5);
+}
+
+/**
+ * Serializes all the features of the layer to a GeoJSON FeatureCollection.
+ *
+ * The text is written natively in one pass, without creating a
+ * `gdal.Feature` or any intermediate object. Integer and real fields are
+ * written as numbers, other fields as their OGR string representation.
+ * The feature pointer is reset.
+ *
+ * @example
+ * ```
+ * const json = layer.toGeoJSONString({ precision: 6, bbox: true });```
+ *
+ * @method toGeoJSONString
+ * @throws Error
+ * @param {Object} [options]
+ * @param {Number} [options.precision] Number of decimals of the coordinates,
+ * by default they are written without any loss
+ * @param {Boolean} [options.bbox=false] Write the bounding boxes of the features and of the collection
+ * @return {String}
+ */
+
+/**
+ * Asynchronously serializes all the features of the layer to a GeoJSON FeatureCollection.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @method toGeoJSONStringAsync
+ * @param {Object} [options]
+ * @param {Number} [options.precision] Number of decimals of the coordinates,
+ * by default they are written without any loss
+ * @param {Boolean} [options.bbox=false] Write the bounding boxes of the features and of the collection
+ * @param {AbortSignal} [options.signal] Allows to abort the operation
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<String>}
+ */
+GDAL_ASYNCABLE_DEFINE(Layer::toGeoJSONString) {
+  Nan::HandleScope scope;
+
+  Layer *layer = Nan::ObjectWrap::Unwrap<Layer>(info.This());
+  if (!layer->isAlive()) {
+    Nan::ThrowError("Layer object has already been destroyed");
+    return;
+  }
+
+  int precision = -1;
+  bool bbox = false;
+  NODE_ARG_INT_OPT(0, "precision", precision);
+  NODE_ARG_BOOL_OPT(1, "bbox", bbox);
+  if (info.Length() > 0 && !info[0]->IsUndefined() && !info[0]->IsNull() && (precision < 0 || precision > 17)) {
+    Nan::ThrowRangeError("precision must be between 0 and 17");
+    return;
+  }
+
+  GDALAsyncableJob<std::shared_ptr<std::string>> job;
+  if (async && !AsyncProgress::parse(info, 2, job.progress)) return;
+
+  OGRLayer *gdal_layer = layer->this_;
+  AsyncLockRef async_lock = layer->async_lock;
+  AsyncProgress *progress = job.progress;
+  job.persist(info.This());
+  job.main = [gdal_layer, async_lock, precision, bbox, progress]() {
+    GeoJSON::Writer writer(precision, bbox);
+    AsyncLockGuard lock({async_lock});
+    gdal_layer->ResetReading();
+    writer.beginCollection();
+    OGRFeature *feature;
+    while ((feature = gdal_layer->GetNextFeature()) != nullptr) {
+      std::unique_ptr<OGRFeature, void (*)(OGRFeature *)> owned(feature, OGRFeature::DestroyFeature);
+      if (progress != nullptr && progress->aborted()) throw AsyncAbortedMessage;
+      writer.feature(feature);
+    }
+    writer.endCollection();
+    if (writer.str().size() > static_cast<size_t>(String::kMaxLength))
+      throw "GeoJSON output exceeds the maximum string length";
+    return std::make_shared<std::string>(std::move(writer.str()));
+  };
+  job.rval = [](std::shared_ptr<std::string> json) -> Local<Value> {
+    Nan::EscapableHandleScope scope;
+    return scope.Escape(Nan::New(*json).ToLocalChecked());
+  };
+  job.run(info, async, 4);
+}
+
 /*
 NAN_METHOD(Layer::getLayerDefn)
 {
@@ -11,6 +11,7 @@
 // ogr
 #include <ogrsf_frmts.h>
 
+#include "async/async_worker.hpp"
 #include "gdal_dataset.hpp"
 #include "utils/obj_cache.hpp"
 
@@ -38,6 +39,8 @@ class Layer : public Nan::ObjectWrap {
   static NAN_METHOD(getSpatialFilter);
   static NAN_METHOD(testCapability);
   static NAN_METHOD(syncToDisk);
+  GDAL_ASYNCABLE_DECLARE(readColumns);
+  GDAL_ASYNCABLE_DECLARE(toGeoJSONString);
 
   static NAN_SETTER(dsSetter);
   static NAN_GETTER(dsGetter);
@@ -71,6 +74,11 @@ class Layer : public Nan::ObjectWrap {
 #endif
   void dispose();
   long uid;
+  /* Dataset manages the async lock lifetime
+   * Layer carries it
+   * LayerFeatures uses it
+   */
+  AsyncLockRef async_lock;
 
     private:
   ~Layer();
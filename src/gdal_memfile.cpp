@@ -1,10 +1,17 @@
 #include "gdal_memfile.hpp"
+#include "gdal_common.hpp"
+
+#include <atomic>
+#include <vector>
 
 namespace node_gdal {
 
 std::map<void *, Memfile *> Memfile::memfile_collection;
+std::list<Memfile *> Memfile::lru;
+size_t Memfile::total_bytes = 0;
+size_t Memfile::max_bytes = 0;
 
-Memfile::Memfile(void *data, size_t len) : data(data), len(len) {
+Memfile::Memfile(void *data, size_t len) : data(data), len(len), weakHandle(nullptr) {
   char _filename[32];
   // The pointer makes for a perfect unique filename
   snprintf(_filename, sizeof(_filename), "/vsimem/%p", data);
@@ -13,20 +20,53 @@ Memfile::Memfile(void *data, size_t len) : data(data), len(len) {
 
 void Memfile::weakCallback(const Nan::WeakCallbackInfo<Memfile> &file) {
   Memfile *mem = file.GetParameter();
-  memfile_collection.erase(mem->data);
-  VSIUnlink(mem->filename.c_str());
+  mem->release();
   delete mem;
 }
 
+// GDAL counts the references to a /vsimem/ file, the datasets
+// that are already open keep working after the file is unlinked
+void Memfile::release() {
+  VSIUnlink(filename.c_str());
+  memfile_collection.erase(data);
+  lru.erase(lru_pos);
+  total_bytes -= len;
+  if (weakHandle != nullptr) {
+    weakHandle->Reset();
+    delete weakHandle;
+    weakHandle = nullptr;
+  }
+}
+
+void Memfile::evict(Memfile *keep) {
+  if (max_bytes == 0) return;
+  std::vector<Memfile *> victims;
+  size_t bytes = total_bytes;
+  for (auto it = lru.rbegin(); it != lru.rend() && bytes > max_bytes; it++) {
+    if (*it == keep) continue;
+    victims.push_back(*it);
+    bytes -= (*it)->len;
+  }
+  for (Memfile *mem : victims) {
+    mem->release();
+    delete mem;
+  }
+}
+
 Memfile *Memfile::get(Local<Object> buffer) {
   void *data = node::Buffer::Data(buffer);
-  if (memfile_collection.count(data)) return memfile_collection.find(data)->second;
+  auto existing = memfile_collection.find(data);
+  if (existing != memfile_collection.end()) {
+    Memfile *mem = existing->second;
+    lru.splice(lru.begin(), lru, mem->lru_pos);
+    return mem;
+  }
 
   size_t len = node::Buffer::Length(buffer);
   Memfile *mem = new Memfile(data, len);
 
   VSILFILE *vsi = VSIFileFromMemBuffer(mem->filename.c_str(), (GByte *)data, len, 0);
-  if (mem->data == nullptr) {
+  if (vsi == nullptr) {
     delete mem;
     return nullptr;
   }
@@ -36,7 +76,186 @@ Memfile *Memfile::get(Local<Object> buffer) {
   mem->weakHandle->SetWeak(mem, weakCallback, Nan::WeakCallbackType::kParameter);
 
   memfile_collection[data] = mem;
+  mem->lru_pos = lru.insert(lru.begin(), mem);
+  total_bytes += len;
+  evict(mem);
   return mem;
 }
 
+void Memfile::Initialize(Local<Object> target) {
+  Local<Object> vsimem = Nan::New<Object>();
+  Nan::Set(target, Nan::New("vsimem").ToLocalChecked(), vsimem);
+  Nan::SetMethod(vsimem, "release", vsimemRelease);
+  Nan::SetMethod(vsimem, "unlinkBuffer", vsimemUnlinkBuffer);
+  Nan::SetMethod(vsimem, "setMaxBufferBytes", vsimemSetMaxBufferBytes);
+  Nan::SetMethod(vsimem, "getBufferStats", vsimemGetBufferStats);
+}
+
+const char *Memfile::take(const std::string &filename, GByte *&data, size_t &len) {
+  vsi_l_offset size;
+
+  data = VSIGetMemFileBuffer(filename.c_str(), &size, FALSE);
+  if (data == nullptr) return "File does not exist";
+  if (size > node::Buffer::kMaxLength) return "File is too large for a Buffer";
+
+  data = VSIGetMemFileBuffer(filename.c_str(), &size, TRUE);
+  len = static_cast<size_t>(size);
+  return nullptr;
+}
+
+Local<Object> Memfile::toBuffer(GByte *data, size_t len) {
+  Nan::EscapableHandleScope scope;
+  if (len == 0) {
+    VSIFree(data);
+    return scope.Escape(Nan::NewBuffer(0).ToLocalChecked());
+  }
+  return scope.Escape(
+    Nan::NewBuffer(reinterpret_cast<char *>(data), len, [](char *data, void *) { VSIFree(data); }, nullptr)
+      .ToLocalChecked());
+}
+
+void Memfile::unlinkDir(const std::string &dir) {
+  char **files = VSIReadDir(dir.c_str());
+  for (int i = 0; files != nullptr && files[i] != nullptr; i++) {
+    std::string file = dir + "/" + files[i];
+    VSIStatBufL stat;
+    if (VSIStatL(file.c_str(), &stat) == 0 && VSI_ISDIR(stat.st_mode))
+      unlinkDir(file);
+    else
+      VSIUnlink(file.c_str());
+  }
+  CSLDestroy(files);
+  VSIRmdir(dir.c_str());
+}
+
+std::string Memfile::tempDir() {
+  static std::atomic<unsigned int> counter(0);
+  char dir[64];
+  snprintf(dir, sizeof(dir), "/vsimem/node-gdal-%u", counter++);
+  return dir;
+}
+
+/**
+ * Functions for working with GDAL in-memory files (`/vsimem/`).
+ *
+ * @class gdal.vsimem
+ */
+
+/**
+ * Removes an in-memory file and returns its content as a Buffer, without
+ * copying it. The file must not be open.
+ *
+ * ```
+ * const ds = gdal.open('/vsimem/temp.tif', 'w', 'GTiff', 256, 256, 1);
+ * // ... write the data
+ * ds.close();
+ * const buffer = gdal.vsimem.release('/vsimem/temp.tif');```
+ *
+ * @static
+ * @method release
+ * @throws Error
+ * @param {String} filename A `/vsimem/` path
+ * @return {Buffer}
+ */
+NAN_METHOD(Memfile::vsimemRelease) {
+  Nan::HandleScope scope;
+  std::string filename;
+
+  NODE_ARG_STR(0, "filename", filename);
+
+  // the data of a file created from a Buffer belongs to the Buffer
+  GByte *data = VSIGetMemFileBuffer(filename.c_str(), nullptr, FALSE);
+  if (data != nullptr && memfile_collection.count(data)) {
+    Nan::ThrowError("File is backed by a Buffer");
+    return;
+  }
+
+  size_t len;
+  const char *err = take(filename, data, len);
+  if (err != nullptr) {
+    Nan::ThrowError(err);
+    return;
+  }
+  info.GetReturnValue().Set(toBuffer(data, len));
+}
+
+/**
+ * Removes the in-memory file created when a Buffer was opened with
+ * {{#crossLink "gdal/open:method"}}gdal.open(){{/crossLink}}, without waiting
+ * for the garbage collector.
+ *
+ * The datasets that are already open keep working, opening the Buffer again
+ * creates a new file.
+ *
+ * @static
+ * @method unlinkBuffer
+ * @param {Buffer} buffer
+ * @return {Boolean} `false` if there was no file for this Buffer
+ */
+NAN_METHOD(Memfile::vsimemUnlinkBuffer) {
+  Nan::HandleScope scope;
+  Local<Object> buffer;
+
+  NODE_ARG_OBJECT(0, "buffer", buffer);
+  if (!node::Buffer::HasInstance(buffer)) {
+    Nan::ThrowTypeError("buffer must be a Buffer");
+    return;
+  }
+
+  auto it = memfile_collection.find(node::Buffer::Data(buffer));
+  if (it == memfile_collection.end()) {
+    info.GetReturnValue().Set(Nan::False());
+    return;
+  }
+  Memfile *mem = it->second;
+  mem->release();
+  delete mem;
+  info.GetReturnValue().Set(Nan::True());
+}
+
+/**
+ * Limits the total size of the Buffers that have an in-memory file.
+ *
+ * When the limit is exceeded, the files of the least recently opened Buffers
+ * are removed as with {{#crossLink "gdal.vsimem/unlinkBuffer:method"}}unlinkBuffer(){{/crossLink}},
+ * allowing the garbage collector to free the Buffers that are not used
+ * anymore. A driver that reopens a file by name after it has been removed will
+ * fail.
+ *
+ * @static
+ * @method setMaxBufferBytes
+ * @param {Number} bytes `0` to disable the limit (the default)
+ */
+NAN_METHOD(Memfile::vsimemSetMaxBufferBytes) {
+  Nan::HandleScope scope;
+  double bytes;
+
+  NODE_ARG_DOUBLE(0, "bytes", bytes);
+  if (bytes < 0) {
+    Nan::ThrowRangeError("bytes must not be negative");
+    return;
+  }
+
+  max_bytes = static_cast<size_t>(bytes);
+  evict(nullptr);
+}
+
+/**
+ * Returns the number and the total size of the Buffers that have an in-memory
+ * file.
+ *
+ * @static
+ * @method getBufferStats
+ * @return {Object} `{count, bytes, maxBytes}`
+ */
+NAN_METHOD(Memfile::vsimemGetBufferStats) {
+  Nan::HandleScope scope;
+
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, Nan::New("count").ToLocalChecked(), Nan::New<Number>(static_cast<double>(lru.size())));
+  Nan::Set(result, Nan::New("bytes").ToLocalChecked(), Nan::New<Number>(static_cast<double>(total_bytes)));
+  Nan::Set(result, Nan::New("maxBytes").ToLocalChecked(), Nan::New<Number>(static_cast<double>(max_bytes)));
+  info.GetReturnValue().Set(result);
+}
+
 } // namespace node_gdal
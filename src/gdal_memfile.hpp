@@ -12,6 +12,8 @@
 // gdal
 #include <gdal_priv.h>
 
+#include <list>
+
 #include "utils/obj_cache.hpp"
 
 using namespace v8;
@@ -25,14 +27,43 @@ class Memfile {
   void *data;
   size_t len;
   Nan::Persistent<Object> *weakHandle;
+  std::list<Memfile *>::iterator lru_pos;
   static void weakCallback(const Nan::WeakCallbackInfo<Memfile> &);
+  // Releases the least recently used files until the total size
+  // is below max_bytes, keep is never released
+  static void evict(Memfile *keep);
 
     public:
   std::string filename;
   Memfile(void *, size_t);
   static Memfile *get(Local<Object>);
+  // Unlinks the file and removes it from the registry,
+  // the Memfile must be deleted afterwards
   void release();
   static std::map<void *, Memfile *> memfile_collection;
+  // Most recently used first
+  static std::list<Memfile *> lru;
+  static size_t total_bytes;
+  // 0 means no limit
+  static size_t max_bytes;
+
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(vsimemRelease);
+  static NAN_METHOD(vsimemUnlinkBuffer);
+  static NAN_METHOD(vsimemSetMaxBufferBytes);
+  static NAN_METHOD(vsimemGetBufferStats);
+
+  // Unlinks a /vsimem/ file that owns its data and takes the ownership
+  // of the data, does not access V8 and can be called from any thread
+  // Returns an error message or nullptr
+  static const char *take(const std::string &filename, GByte *&data, size_t &len);
+  // Wraps data taken from /vsimem/ in a Buffer without copying it,
+  // the data is freed by the garbage collector
+  static Local<Object> toBuffer(GByte *data, size_t len);
+  // Removes a /vsimem/ directory and all the files in it
+  static void unlinkDir(const std::string &dir);
+  // A new unique /vsimem/ directory name
+  static std::string tempDir();
 };
 } // namespace node_gdal
 #endif
@@ -6,6 +6,7 @@
 #include "gdal_dataset.hpp"
 #include "gdal_majorobject.hpp"
 #include "gdal_rasterband.hpp"
+#include "utils/pinned_block.hpp"
 
 #include <cpl_port.h>
 #include <limits>
@@ -25,13 +26,14 @@ void RasterBand::Initialize(Local<Object> target) {
   Nan::SetPrototypeMethod(lcons, "toString", toString);
   Nan::SetPrototypeMethod(lcons, "flush", flush);
   Nan::SetPrototypeMethod(lcons, "fill", fill);
-  Nan::SetPrototypeMethod(lcons, "getStatistics", getStatistics);
+  SET_ASYNCABLE_METHOD(lcons, "getStatistics", getStatistics);
   Nan::SetPrototypeMethod(lcons, "setStatistics", setStatistics);
-  Nan::SetPrototypeMethod(lcons, "computeStatistics", computeStatistics);
+  SET_ASYNCABLE_METHOD(lcons, "computeStatistics", computeStatistics);
   Nan::SetPrototypeMethod(lcons, "getMaskBand", getMaskBand);
   Nan::SetPrototypeMethod(lcons, "getMaskFlags", getMaskFlags);
   Nan::SetPrototypeMethod(lcons, "createMaskBand", createMaskBand);
   Nan::SetPrototypeMethod(lcons, "getMetadata", getMetadata);
+  Nan::SetPrototypeMethod(lcons, "mapVirtualMemory", mapVirtualMemory);
 
   // unimplemented methods
   // Nan::SetPrototypeMethod(lcons, "buildOverviews", buildOverviews);
@@ -142,7 +144,7 @@ Local<Value> RasterBand::New(GDALRasterBand *raw, GDALDataset *raw_parent) {
   // https://github.com/naturalatlas/node-gdal/blob/master/deps/libgdal/gdal/frmts/gtiff/geotiff.cpp#L84
 
   Local<Object> ds;
-  uv_mutex_t *async_lock;
+  AsyncLockRef async_lock;
   if (!Dataset::dataset_cache.has(raw_parent)) {
     LOG("Band's parent dataset disappeared from cache (band = %p, dataset = %p)", raw, raw_parent);
     Nan::ThrowError("Band's parent dataset disappeared from cache");
@@ -157,6 +159,7 @@ Local<Value> RasterBand::New(GDALRasterBand *raw, GDALDataset *raw_parent) {
   wrapped->uid = ptr_manager.add(raw, parent_uid);
   wrapped->parent_ds = raw_parent;
   wrapped->async_lock = async_lock;
+  wrapped->pool = parent->pool;
   Nan::SetPrivate(obj, Nan::New("ds_").ToLocalChecked(), ds);
 
   return scope.Escape(obj);
@@ -172,7 +175,18 @@ NAN_METHOD(RasterBand::toString) {
  *
  * @method flush
  */
-NODE_WRAPPED_METHOD(RasterBand, flush, FlushCache);
+NAN_METHOD(RasterBand::flush) {
+  Nan::HandleScope scope;
+  RasterBand *band = Nan::ObjectWrap::Unwrap<RasterBand>(info.This());
+  if (!band->isAlive()) {
+    Nan::ThrowError("RasterBand object has already been destroyed");
+    return;
+  }
+  PinnedBlock::releaseAll(band->getParent(), true);
+  band->async_lock->lock();
+  band->get()->FlushCache();
+  band->async_lock->unlock();
+}
 
 /**
  * Return the status flags of the mask band associated with the band.
@@ -222,9 +236,9 @@ NAN_METHOD(RasterBand::getMaskBand) {
     return;
   }
 
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   GDALRasterBand *mask_band = band->this_->GetMaskBand();
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
 
   if (!mask_band) {
     info.GetReturnValue().Set(Nan::Null());
@@ -254,9 +268,9 @@ NAN_METHOD(RasterBand::fill) {
     return;
   }
 
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   int err = band->this_->Fill(real, imaginary);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
 
   if (err) {
     NODE_THROW_CPLERR(err);
@@ -267,19 +281,34 @@ NAN_METHOD(RasterBand::fill) {
 
 // --- Custom error handling to handle VRT errors ---
 // see: https://github.com/mapbox/mapnik-omnivore/issues/10
+//
+// The handler is pushed on the error handler stack of the calling thread
+// only, statistics can be computed on several threads at the same time
 
-std::string stats_file_err = "";
-CPLErrorHandler last_err_handler;
-void CPL_STDCALL statisticsErrorHandler(CPLErr eErrClass, int err_no, const char *msg) {
+static thread_local std::string stats_file_err;
+static void CPL_STDCALL statisticsErrorHandler(CPLErr eErrClass, int err_no, const char *msg) {
   if (err_no == CPLE_OpenFailed) { stats_file_err = msg; }
-  if (last_err_handler) { last_err_handler(eErrClass, err_no, msg); }
 }
-void pushStatsErrorHandler() {
-  last_err_handler = CPLSetErrorHandler(statisticsErrorHandler);
+static void pushStatsErrorHandler() {
+  stats_file_err.clear();
+  CPLPushErrorHandler(statisticsErrorHandler);
+}
+static void popStatsErrorHandler() {
+  CPLPopErrorHandler();
 }
-void popStatsErrorHandler() {
-  if (!last_err_handler) return;
-  CPLSetErrorHandler(last_err_handler);
+
+struct BandStatistics {
+  double min, max, mean, std_dev;
+};
+
+static Local<Value> statisticsToObject(const BandStatistics &stats) {
+  Nan::EscapableHandleScope scope;
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, Nan::New("min").ToLocalChecked(), Nan::New<Number>(stats.min));
+  Nan::Set(result, Nan::New("max").ToLocalChecked(), Nan::New<Number>(stats.max));
+  Nan::Set(result, Nan::New("mean").ToLocalChecked(), Nan::New<Number>(stats.mean));
+  Nan::Set(result, Nan::New("std_dev").ToLocalChecked(), Nan::New<Number>(stats.std_dev));
+  return scope.Escape(result);
 }
 
 /**
@@ -299,9 +328,24 @@ void popStatsErrorHandler() {
  * @return {Object} Statistics containing `"min"`, `"max"`, `"mean"`,
  * `"std_dev"` properties.
  */
-NAN_METHOD(RasterBand::getStatistics) {
+
+/**
+ * Asynchronously fetch image statistics.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @throws Error
+ * @method getStatisticsAsync
+ * @param {Boolean} allow_approximation If `true` statistics may be computed
+ * based on overviews or a subset of all tiles.
+ * @param {Boolean} force If `false` statistics will only be returned if it can
+ * be done without rescanning the image.
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<Object>} Statistics containing `"min"`, `"max"`, `"mean"`,
+ * `"std_dev"` properties.
+ */
+GDAL_ASYNCABLE_DEFINE(RasterBand::getStatistics) {
   Nan::HandleScope scope;
-  double min, max, mean, std_dev;
   int approx, force;
   NODE_ARG_BOOL(0, "allow approximation", approx);
   NODE_ARG_BOOL(1, "force", force);
@@ -312,29 +356,26 @@ NAN_METHOD(RasterBand::getStatistics) {
     return;
   }
 
-  uv_mutex_lock(band->async_lock);
-  pushStatsErrorHandler();
-  CPLErr err = band->this_->GetStatistics(approx, force, &min, &max, &mean, &std_dev);
-  popStatsErrorHandler();
-  uv_mutex_unlock(band->async_lock);
-  if (!stats_file_err.empty()) {
-    Nan::ThrowError(stats_file_err.c_str());
-  } else if (err) {
-    if (!force && err == CE_Warning) {
-      Nan::ThrowError("Statistics cannot be efficiently computed without scanning raster");
-      return;
+  GDALRasterBand *gdal_band = band->this_;
+  AsyncLockRef async_lock = band->async_lock;
+  GDALAsyncableJob<BandStatistics> job;
+  job.persist(info.This());
+  job.main = [gdal_band, async_lock, approx, force]() {
+    BandStatistics stats;
+    AsyncLockGuard lock({async_lock});
+    pushStatsErrorHandler();
+    CPLErr err = gdal_band->GetStatistics(approx, force, &stats.min, &stats.max, &stats.mean, &stats.std_dev);
+    popStatsErrorHandler();
+    if (!stats_file_err.empty()) {
+      throw stats_file_err.c_str();
+    } else if (err) {
+      if (!force && err == CE_Warning) throw "Statistics cannot be efficiently computed without scanning raster";
+      throw CPLGetLastErrorMsg();
     }
-    NODE_THROW_CPLERR(err);
-    return;
-  }
-
-  Local<Object> result = Nan::New<Object>();
-  Nan::Set(result, Nan::New("min").ToLocalChecked(), Nan::New<Number>(min));
-  Nan::Set(result, Nan::New("max").ToLocalChecked(), Nan::New<Number>(max));
-  Nan::Set(result, Nan::New("mean").ToLocalChecked(), Nan::New<Number>(mean));
-  Nan::Set(result, Nan::New("std_dev").ToLocalChecked(), Nan::New<Number>(std_dev));
-
-  info.GetReturnValue().Set(result);
+    return stats;
+  };
+  job.rval = statisticsToObject;
+  job.run(info, async, 2);
 }
 
 /**
@@ -352,9 +393,25 @@ NAN_METHOD(RasterBand::getStatistics) {
  * @return {Object} Statistics containing `"min"`, `"max"`, `"mean"`,
  * `"std_dev"` properties.
  */
-NAN_METHOD(RasterBand::computeStatistics) {
+
+/**
+ * Asynchronously computes image statistics.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * @throws Error
+ * @method computeStatisticsAsync
+ * @param {Boolean} allow_approximation If `true` statistics may be computed
+ * based on overviews or a subset of all tiles.
+ * @param {JobOptions} [options]
+ * @param {Function} [options.progress_cb] Progress callback, called with the completion ratio
+ * @param {AbortSignal} [options.signal] Aborts the operation
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<Object>} Statistics containing `"min"`, `"max"`, `"mean"`,
+ * `"std_dev"` properties.
+ */
+GDAL_ASYNCABLE_DEFINE(RasterBand::computeStatistics) {
   Nan::HandleScope scope;
-  double min, max, mean, std_dev;
   int approx;
   NODE_ARG_BOOL(0, "allow approximation", approx);
 
@@ -364,25 +421,35 @@ NAN_METHOD(RasterBand::computeStatistics) {
     return;
   }
 
-  uv_mutex_lock(band->async_lock);
-  pushStatsErrorHandler();
-  CPLErr err = band->this_->ComputeStatistics(approx, &min, &max, &mean, &std_dev, NULL, NULL);
-  popStatsErrorHandler();
-  uv_mutex_unlock(band->async_lock);
-  if (!stats_file_err.empty()) {
-    Nan::ThrowError(stats_file_err.c_str());
-  } else if (err) {
-    NODE_THROW_CPLERR(err);
-    return;
-  }
-
-  Local<Object> result = Nan::New<Object>();
-  Nan::Set(result, Nan::New("min").ToLocalChecked(), Nan::New<Number>(min));
-  Nan::Set(result, Nan::New("max").ToLocalChecked(), Nan::New<Number>(max));
-  Nan::Set(result, Nan::New("mean").ToLocalChecked(), Nan::New<Number>(mean));
-  Nan::Set(result, Nan::New("std_dev").ToLocalChecked(), Nan::New<Number>(std_dev));
-
-  info.GetReturnValue().Set(result);
+  GDALAsyncableJob<BandStatistics> job;
+  if (async && !AsyncProgress::parse(info, 1, job.progress)) return;
+  job.persist(info.This());
+
+  GDALRasterBand *gdal_band = band->this_;
+  AsyncLockRef async_lock = band->async_lock;
+  AsyncProgress *progress = job.progress;
+  job.main = [gdal_band, async_lock, approx, progress]() {
+    BandStatistics stats;
+    AsyncLockGuard lock({async_lock});
+    pushStatsErrorHandler();
+    CPLErr err = gdal_band->ComputeStatistics(
+      approx,
+      &stats.min,
+      &stats.max,
+      &stats.mean,
+      &stats.std_dev,
+      progress ? AsyncProgress::progress : NULL,
+      progress);
+    popStatsErrorHandler();
+    if (!stats_file_err.empty()) {
+      throw stats_file_err.c_str();
+    } else if (err) {
+      throw CPLGetLastErrorMsg();
+    }
+    return stats;
+  };
+  job.rval = statisticsToObject;
+  job.run(info, async, 3);
 }
 
 /**
@@ -411,9 +478,9 @@ NAN_METHOD(RasterBand::setStatistics) {
     return;
   }
 
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   CPLErr err = band->this_->SetStatistics(min, max, mean, std_dev);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
 
   if (err) {
     NODE_THROW_CPLERR(err);
@@ -422,6 +489,101 @@ NAN_METHOD(RasterBand::setStatistics) {
   return;
 }
 
+/**
+ * Maps the whole band in virtual memory (Linux only).
+ *
+ * The pixels are read from the dataset when the memory is first accessed,
+ * the kernel pages them in and out. Uncompressed raw formats and untiled
+ * uncompressed GeoTIFF files are mapped directly from the file, other formats
+ * go through a page cache of `cacheSize` bytes.
+ *
+ * The value of the pixel at (x, y) starts at byte `y * lineSpace + x * pixelSpace`.
+ * A band larger than the maximum size of an ArrayBuffer (`buffer.constants.MAX_LENGTH`)
+ * cannot be mapped.
+ *
+ * The mapping is freed when the buffer is garbage collected or when the
+ * dataset is closed, the buffer is then detached. The async methods must not
+ * be used on the dataset while the mapped memory is accessed.
+ *
+ * ```
+ * const { buffer, pixelSpace, lineSpace } = band.mapVirtualMemory();
+ * const view = new DataView(buffer);
+ * const value = view.getUint16(y * lineSpace + x * pixelSpace, true);```
+ *
+ * @method mapVirtualMemory
+ * @throws Error
+ * @param {Object} [options]
+ * @param {String} [options.mode='r'] `'r'` or `'w'`, the changes are written
+ * to the dataset when the mapping is freed
+ * @param {Number} [options.cacheSize=40000000] Size of the page cache in bytes
+ * @param {Number} [options.pageSizeHint] Page size in bytes
+ * @return {Object} `{buffer, pixelSpace, lineSpace}`: an ArrayBuffer in the
+ * native byte order and the byte offsets between two pixels and two lines
+ */
+NAN_METHOD(RasterBand::mapVirtualMemory) {
+  Nan::HandleScope scope;
+
+  RasterBand *band = Nan::ObjectWrap::Unwrap<RasterBand>(info.This());
+  if (!band->isAlive()) {
+    Nan::ThrowError("RasterBand object has already been destroyed");
+    return;
+  }
+
+#ifdef __linux__
+  Local<Object> options;
+  NODE_ARG_OBJECT_OPT(0, "options", options);
+
+  GDALRWFlag flag = GF_Read;
+  char **papszOptions = nullptr;
+  if (!options.IsEmpty()) {
+    Local<Value> mode = Nan::Get(options, Nan::New("mode").ToLocalChecked()).ToLocalChecked();
+    if (!mode->IsUndefined()) {
+      std::string mode_str = *Nan::Utf8String(mode);
+      if (mode_str == "w")
+        flag = GF_Write;
+      else if (mode_str != "r") {
+        Nan::ThrowError("mode must be 'r' or 'w'");
+        return;
+      }
+    }
+    const char *keys[][2] = {{"cacheSize", "CACHE_SIZE"}, {"pageSizeHint", "PAGE_SIZE_HINT"}};
+    for (auto &key : keys) {
+      Local<Value> val = Nan::Get(options, Nan::New(key[0]).ToLocalChecked()).ToLocalChecked();
+      if (val->IsUndefined()) continue;
+      if (!val->IsUint32()) {
+        Nan::ThrowTypeError((std::string(key[0]) + " must be a positive integer").c_str());
+        CSLDestroy(papszOptions);
+        return;
+      }
+      papszOptions = CSLSetNameValue(papszOptions, key[1], CPLSPrintf("%u", Nan::To<uint32_t>(val).ToChecked()));
+    }
+  }
+
+  int pixel_space;
+  GIntBig line_space;
+  band->async_lock->lock();
+  CPLVirtualMem *vmem = GDALGetVirtualMemAuto(band->this_, flag, &pixel_space, &line_space, papszOptions);
+  band->async_lock->unlock();
+  CSLDestroy(papszOptions);
+
+  if (vmem == nullptr) {
+    NODE_THROW_LAST_CPLERR();
+    return;
+  }
+
+  Local<Object> buffer = PinnedBlock::New(info.This(), band->getParent(), vmem);
+  if (buffer.IsEmpty()) return; // PinnedBlock::New threw an error
+
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, Nan::New("buffer").ToLocalChecked(), buffer);
+  Nan::Set(result, Nan::New("pixelSpace").ToLocalChecked(), Nan::New<Number>(pixel_space));
+  Nan::Set(result, Nan::New("lineSpace").ToLocalChecked(), Nan::New<Number>(static_cast<double>(line_space)));
+  info.GetReturnValue().Set(result);
+#else
+  Nan::ThrowError("Virtual memory mappings are only supported on Linux");
+#endif
+}
+
 /**
  * Returns band metadata
  *
@@ -439,10 +601,10 @@ NAN_METHOD(RasterBand::getMetadata) {
     Nan::ThrowError("RasterBand object has already been destroyed");
     return;
   }
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   const Nan::ADDON_REGISTER_FUNCTION_ARGS_TYPE &meta =
     MajorObject::getMetadata(band->this_, domain.empty() ? NULL : domain.c_str());
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   info.GetReturnValue().Set(meta);
 }
 
@@ -489,9 +651,9 @@ NAN_GETTER(RasterBand::idGetter) {
     return;
   }
 
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   int id = band->this_->GetBand();
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
 
   if (id == 0) {
     info.GetReturnValue().Set(Nan::Null());
@@ -517,9 +679,9 @@ NAN_GETTER(RasterBand::descriptionGetter) {
     Nan::ThrowError("RasterBand object has already been destroyed");
     return;
   }
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   const char *desc = band->this_->GetDescription();
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
 
   info.GetReturnValue().Set(SafeString::New(desc));
 }
@@ -540,10 +702,10 @@ NAN_GETTER(RasterBand::sizeGetter) {
   }
 
   Local<Object> result = Nan::New<Object>();
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   int x = band->this_->GetXSize();
   int y = band->this_->GetYSize();
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   Nan::Set(result, Nan::New("x").ToLocalChecked(), Nan::New<Integer>(x));
   Nan::Set(result, Nan::New("y").ToLocalChecked(), Nan::New<Integer>(y));
   info.GetReturnValue().Set(result);
@@ -565,9 +727,9 @@ NAN_GETTER(RasterBand::blockSizeGetter) {
   }
 
   int x, y;
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   band->this_->GetBlockSize(&x, &y);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
 
   Local<Object> result = Nan::New<Object>();
   Nan::Set(result, Nan::New("x").ToLocalChecked(), Nan::New<Integer>(x));
@@ -591,9 +753,9 @@ NAN_GETTER(RasterBand::minimumGetter) {
   }
 
   int success = 0;
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   double result = band->this_->GetMinimum(&success);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   info.GetReturnValue().Set(Nan::New<Number>(result));
 }
 
@@ -613,9 +775,9 @@ NAN_GETTER(RasterBand::maximumGetter) {
   }
 
   int success = 0;
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   double result = band->this_->GetMaximum(&success);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   info.GetReturnValue().Set(Nan::New<Number>(result));
 }
 
@@ -634,9 +796,9 @@ NAN_GETTER(RasterBand::offsetGetter) {
   }
 
   int success = 0;
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   double result = band->this_->GetOffset(&success);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   info.GetReturnValue().Set(Nan::New<Number>(result));
 }
 
@@ -655,9 +817,9 @@ NAN_GETTER(RasterBand::scaleGetter) {
   }
 
   int success = 0;
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   double result = band->this_->GetScale(&success);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   info.GetReturnValue().Set(Nan::New<Number>(result));
 }
 
@@ -676,9 +838,9 @@ NAN_GETTER(RasterBand::noDataValueGetter) {
   }
 
   int success = 0;
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   double result = band->this_->GetNoDataValue(&success);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
 
   if (success && !CPLIsNan(result)) {
     info.GetReturnValue().Set(Nan::New<Number>(result));
@@ -706,9 +868,9 @@ NAN_GETTER(RasterBand::unitTypeGetter) {
     return;
   }
 
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   const char *result = band->this_->GetUnitType();
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   info.GetReturnValue().Set(SafeString::New(result));
 }
 
@@ -728,9 +890,9 @@ NAN_GETTER(RasterBand::dataTypeGetter) {
     return;
   }
 
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   GDALDataType type = band->this_->GetRasterDataType();
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
 
   if (type == GDT_Unknown) return;
   info.GetReturnValue().Set(SafeString::New(GDALGetDataTypeName(type)));
@@ -751,9 +913,9 @@ NAN_GETTER(RasterBand::readOnlyGetter) {
     return;
   }
 
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   GDALAccess result = band->this_->GetAccess();
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   info.GetReturnValue().Set(result == GA_Update ? Nan::False() : Nan::True());
 }
 
@@ -776,9 +938,9 @@ NAN_GETTER(RasterBand::hasArbitraryOverviewsGetter) {
     return;
   }
 
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   bool result = band->this_->HasArbitraryOverviews();
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   info.GetReturnValue().Set(Nan::New<Boolean>(result));
 }
 
@@ -796,9 +958,9 @@ NAN_GETTER(RasterBand::categoryNamesGetter) {
     return;
   }
 
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   char **names = band->this_->GetCategoryNames();
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
 
   Local<Array> results = Nan::New<Array>();
 
@@ -827,9 +989,9 @@ NAN_GETTER(RasterBand::colorInterpretationGetter) {
     Nan::ThrowError("RasterBand object has already been destroyed");
     return;
   }
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   GDALColorInterp interp = band->this_->GetColorInterpretation();
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   if (interp == GCI_Undefined)
     return;
   else
@@ -849,9 +1011,9 @@ NAN_SETTER(RasterBand::unitTypeSetter) {
     return;
   }
   std::string input = *Nan::Utf8String(value);
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   CPLErr err = band->this_->SetUnitType(input.c_str());
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   if (err) { NODE_THROW_CPLERR(err); }
 }
 
@@ -874,9 +1036,9 @@ NAN_SETTER(RasterBand::noDataValueSetter) {
     return;
   }
 
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   CPLErr err = band->this_->SetNoDataValue(input);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   if (err) { NODE_THROW_CPLERR(err); }
 }
 
@@ -893,9 +1055,9 @@ NAN_SETTER(RasterBand::scaleSetter) {
     return;
   }
   double input = Nan::To<double>(value).ToChecked();
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   CPLErr err = band->this_->SetScale(input);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   if (err) { NODE_THROW_CPLERR(err); }
 }
 
@@ -912,9 +1074,9 @@ NAN_SETTER(RasterBand::offsetSetter) {
     return;
   }
   double input = Nan::To<double>(value).ToChecked();
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   CPLErr err = band->this_->SetOffset(input);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   if (err) { NODE_THROW_CPLERR(err); }
 }
 
@@ -946,9 +1108,9 @@ NAN_SETTER(RasterBand::categoryNamesSetter) {
     list[i] = NULL;
   }
 
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   int err = band->this_->SetCategoryNames(list);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
 
   if (list) { delete[] list; }
 
@@ -973,9 +1135,9 @@ NAN_SETTER(RasterBand::colorInterpretationSetter) {
     return;
   }
 
-  uv_mutex_lock(band->async_lock);
+  band->async_lock->lock();
   CPLErr err = band->this_->SetColorInterpretation(ci);
-  uv_mutex_unlock(band->async_lock);
+  band->async_lock->unlock();
   if (err) { NODE_THROW_CPLERR(err); }
 }
 
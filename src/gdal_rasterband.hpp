@@ -11,6 +11,7 @@
 // gdal
 #include <gdal_priv.h>
 
+#include "async/async_worker.hpp"
 #include "gdal_dataset.hpp"
 #include "utils/obj_cache.hpp"
 
@@ -28,13 +29,14 @@ class RasterBand : public Nan::ObjectWrap {
   static NAN_METHOD(toString);
   static NAN_METHOD(flush);
   static NAN_METHOD(fill);
-  static NAN_METHOD(getStatistics);
-  static NAN_METHOD(computeStatistics);
+  GDAL_ASYNCABLE_DECLARE(getStatistics);
+  GDAL_ASYNCABLE_DECLARE(computeStatistics);
   static NAN_METHOD(setStatistics);
   static NAN_METHOD(getMaskBand);
   static NAN_METHOD(getMaskFlags);
   static NAN_METHOD(createMaskBand);
   static NAN_METHOD(getMetadata);
+  static NAN_METHOD(mapVirtualMemory);
 
   // unimplemented methods
   // static NAN_METHOD(getColorTable);
@@ -91,7 +93,9 @@ class RasterBand : public Nan::ObjectWrap {
    * RasterBand carries it
    * RasterBandPixels uses it
    */
-  uv_mutex_t *async_lock;
+  AsyncLockRef async_lock;
+  // the parent dataset's pool of read-only handles, if any
+  DatasetPoolRef pool;
 
     private:
   ~RasterBand();
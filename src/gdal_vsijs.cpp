@@ -0,0 +1,526 @@
+#include "gdal_vsijs.hpp"
+#include "gdal_common.hpp"
+
+#include <algorithm>
+#include <cstring>
+
+namespace node_gdal {
+
+static const char prefix[] = "/vsijs/";
+static const size_t default_block_size = 64 * 1024;
+static const unsigned int default_read_ahead = 2;
+static const size_t default_cache_size = 16 * 1024 * 1024;
+
+uv_thread_t VSIJS::main_thread;
+uv_async_t *VSIJS::async = nullptr;
+uv_mutex_t VSIJS::files_lock;
+std::map<std::string, std::shared_ptr<VSIJSFile>> VSIJS::files;
+unsigned int VSIJS::last_id = 0;
+uv_mutex_t VSIJS::queue_lock;
+std::deque<VSIJS::Request *> VSIJS::queue;
+std::map<unsigned int, VSIJS::Request *> VSIJS::pending;
+unsigned int VSIJS::last_request = 0;
+uv_mutex_t VSIJS::cache_lock;
+VSIJS::BlockList VSIJS::cache;
+std::map<VSIJS::BlockKey, VSIJS::BlockList::iterator> VSIJS::cache_index;
+size_t VSIJS::cache_bytes = 0;
+size_t VSIJS::cache_max = default_cache_size;
+
+VSIJSFile::VSIJSFile(
+  unsigned int id, vsi_l_offset size, size_t block_size, unsigned int read_ahead, Local<Function> reader)
+  : id(id), size(size), block_size(block_size), read_ahead(read_ahead), reader(new Nan::Callback(reader)) {
+}
+
+static std::string fileName(const char *filename) {
+  if (strncmp(filename, prefix, sizeof(prefix) - 1) != 0) return "";
+  return filename + sizeof(prefix) - 1;
+}
+
+VSIJSHandle::VSIJSHandle(const std::shared_ptr<VSIJSFile> &file) : file(file), offset(0), last_end(0), eof(false) {
+}
+
+int VSIJSHandle::Seek(vsi_l_offset offset, int whence) {
+  switch (whence) {
+    case SEEK_SET: this->offset = offset; break;
+    case SEEK_CUR: this->offset += offset; break;
+    case SEEK_END: this->offset = file->size + offset; break;
+    default: errno = EINVAL; return -1;
+  }
+  eof = false;
+  return 0;
+}
+
+vsi_l_offset VSIJSHandle::Tell() {
+  return offset;
+}
+
+size_t VSIJSHandle::Read(void *buffer, size_t size, size_t count) {
+  size_t len = size * count;
+  if (len == 0) return 0;
+  if (offset >= file->size) {
+    eof = true;
+    return 0;
+  }
+  if (len > file->size - offset) {
+    len = static_cast<size_t>(file->size - offset);
+    eof = true;
+  }
+
+  const size_t bs = file->block_size;
+  const vsi_l_offset last_block = (offset + len - 1) / bs;
+  const bool sequential = offset == last_end;
+  GByte *dest = static_cast<GByte *>(buffer);
+  vsi_l_offset pos = offset;
+
+  while (pos < offset + len) {
+    vsi_l_offset b = pos / bs;
+    VSIJS::Block block = VSIJS::cacheGet(file->id, b);
+    if (block == nullptr) {
+      // the rest of the request is copied from the fetched data, the cache
+      // may not be able to hold it
+      vsi_l_offset blocks = last_block - b + 1 + (sequential ? file->read_ahead : 0);
+      size_t n = static_cast<size_t>(offset + len - pos);
+      std::string err = VSIJS::load(file, b, blocks, pos, n, dest);
+      if (!err.empty()) {
+        CPLError(CE_Failure, CPLE_FileIO, "%s", err.c_str());
+        break;
+      }
+      pos += n;
+      break;
+    }
+    size_t in_block = static_cast<size_t>(pos - b * bs);
+    if (in_block >= block->size()) break;
+    size_t n = std::min(static_cast<size_t>(offset + len - pos), block->size() - in_block);
+    memcpy(dest, block->data() + in_block, n);
+    dest += n;
+    pos += n;
+  }
+
+  size_t read = static_cast<size_t>(pos - offset);
+  if (read < len) eof = true;
+  offset = pos;
+  last_end = pos;
+  return read / size;
+}
+
+size_t VSIJSHandle::Write(const void *, size_t, size_t) {
+  errno = EBADF;
+  return 0;
+}
+
+int VSIJSHandle::Eof() {
+  return eof ? 1 : 0;
+}
+
+int VSIJSHandle::Close() {
+  return 0;
+}
+
+VSIVirtualHandle *VSIJSFilesystemHandler::Open(const char *filename, const char *access, bool) {
+  if (strchr(access, 'w') != nullptr || strchr(access, 'a') != nullptr || strchr(access, '+') != nullptr) {
+    errno = EACCES;
+    return nullptr;
+  }
+  std::shared_ptr<VSIJSFile> file = VSIJS::find(fileName(filename));
+  if (file == nullptr) {
+    errno = ENOENT;
+    return nullptr;
+  }
+  return new VSIJSHandle(file);
+}
+
+int VSIJSFilesystemHandler::Stat(const char *filename, VSIStatBufL *stat, int) {
+  memset(stat, 0, sizeof(VSIStatBufL));
+  std::shared_ptr<VSIJSFile> file = VSIJS::find(fileName(filename));
+  if (file == nullptr) {
+    errno = ENOENT;
+    return -1;
+  }
+  stat->st_size = file->size;
+  stat->st_mode = S_IFREG;
+  return 0;
+}
+
+void VSIJS::Initialize(Local<Object> target) {
+  main_thread = uv_thread_self();
+  uv_mutex_init(&files_lock);
+  uv_mutex_init(&queue_lock);
+  uv_mutex_init(&cache_lock);
+
+  async = new uv_async_t;
+  uv_async_init(Nan::GetCurrentEventLoop(), async, dispatch);
+  // the requests come from jobs that already keep the event loop alive
+  uv_unref(reinterpret_cast<uv_handle_t *>(async));
+
+  VSIFileManager::InstallHandler(prefix, new VSIJSFilesystemHandler);
+
+  Local<Object> vsijs = Nan::New<Object>();
+  Nan::Set(target, Nan::New("vsijs").ToLocalChecked(), vsijs);
+  Nan::SetMethod(vsijs, "register", registerFile);
+  Nan::SetMethod(vsijs, "unregister", unregisterFile);
+  Nan::SetMethod(vsijs, "setCacheSize", setCacheSize);
+}
+
+std::shared_ptr<VSIJSFile> VSIJS::find(const std::string &name) {
+  uv_mutex_lock(&files_lock);
+  auto it = files.find(name);
+  std::shared_ptr<VSIJSFile> file = it != files.end() ? it->second : nullptr;
+  uv_mutex_unlock(&files_lock);
+  return file;
+}
+
+std::string VSIJS::load(
+  const std::shared_ptr<VSIJSFile> &file,
+  vsi_l_offset first,
+  vsi_l_offset count,
+  vsi_l_offset offset,
+  size_t len,
+  GByte *dest) {
+  const size_t bs = file->block_size;
+  vsi_l_offset start = first * bs;
+  size_t size = static_cast<size_t>(std::min<vsi_l_offset>(count * bs, file->size - start));
+
+  std::vector<GByte> data(size);
+  std::string err = fetch(file, start, size, data.data());
+  if (!err.empty()) return err;
+  memcpy(dest, data.data() + (offset - start), len);
+
+  for (size_t pos = 0; pos < size; pos += bs) {
+    size_t end = std::min(pos + bs, size);
+    cachePut(file->id, first + pos / bs, std::make_shared<std::vector<GByte>>(data.begin() + pos, data.begin() + end));
+  }
+  return "";
+}
+
+std::string VSIJS::fetch(const std::shared_ptr<VSIJSFile> &file, vsi_l_offset offset, size_t len, GByte *dest) {
+  uv_thread_t self = uv_thread_self();
+  if (uv_thread_equal(&self, &main_thread))
+    return "Synchronous reads from /vsijs/ files are not supported, use the async methods";
+
+  Request req;
+  req.file = file;
+  req.offset = offset;
+  req.len = len;
+  req.dest = dest;
+  req.done = false;
+  req.locks = AsyncLock::current();
+
+  uv_mutex_lock(&queue_lock);
+  // cancel() has already run for this dataset
+  if (AsyncLock::cancelled()) {
+    uv_mutex_unlock(&queue_lock);
+    return "Dataset object has already been destroyed";
+  }
+  uv_cond_init(&req.cond);
+  queue.push_back(&req);
+  uv_async_send(async);
+  while (!req.done) uv_cond_wait(&req.cond, &queue_lock);
+  uv_mutex_unlock(&queue_lock);
+
+  uv_cond_destroy(&req.cond);
+  return req.error;
+}
+
+// The waiting thread owns the request, it must not be accessed after this
+void VSIJS::complete(Request *req, const std::string &error) {
+  uv_mutex_lock(&queue_lock);
+  completeLocked(req, error);
+  uv_mutex_unlock(&queue_lock);
+}
+
+void VSIJS::completeLocked(Request *req, const std::string &error) {
+  req->error = error;
+  req->done = true;
+  uv_cond_signal(&req->cond);
+}
+
+/*
+ * Called by PtrManager::dispose once lock->closing is set and before it
+ * waits for the lock: the requests queued later fail in fetch(), the
+ * JS callbacks of the pending requests are ignored
+ */
+void VSIJS::cancel(AsyncLock *lock) {
+  auto uses = [lock](Request *req) {
+    return std::find(req->locks.begin(), req->locks.end(), lock) != req->locks.end();
+  };
+  const char *err = "Dataset object has already been destroyed";
+
+  uv_mutex_lock(&queue_lock);
+  for (auto it = queue.begin(); it != queue.end();) {
+    if (uses(*it)) {
+      completeLocked(*it, err);
+      it = queue.erase(it);
+    } else {
+      it++;
+    }
+  }
+  for (auto it = pending.begin(); it != pending.end();) {
+    if (uses(it->second)) {
+      completeLocked(it->second, err);
+      it = pending.erase(it);
+    } else {
+      it++;
+    }
+  }
+  uv_mutex_unlock(&queue_lock);
+}
+
+void VSIJS::dispatch(uv_async_t *) {
+  Nan::HandleScope scope;
+  std::deque<Request *> todo;
+
+  uv_mutex_lock(&queue_lock);
+  todo.swap(queue);
+  uv_mutex_unlock(&queue_lock);
+
+  Nan::AsyncResource resource("node-gdal:vsijs");
+  for (Request *req : todo) {
+    if (req->file->reader == nullptr) {
+      complete(req, "File has been unregistered");
+      continue;
+    }
+    // a previous reader of this batch has closed the dataset
+    if (std::any_of(req->locks.begin(), req->locks.end(), [](AsyncLock *lock) { return lock->closing.load(); })) {
+      complete(req, "Dataset object has already been destroyed");
+      continue;
+    }
+    unsigned int id = ++last_request;
+    pending[id] = req;
+
+    // a plain function, a FunctionTemplate per read would never be freed
+    Local<Function> done = Nan::New<Function>(readCallback, Nan::New<Number>(id));
+    Local<Value> argv[] = {
+      Nan::New<Number>(static_cast<double>(req->offset)), Nan::New<Number>(static_cast<double>(req->len)), done};
+    Nan::TryCatch try_catch;
+    req->file->reader->Call(3, argv, &resource);
+    if (try_catch.HasCaught() && pending.erase(id)) {
+      std::string err = *Nan::Utf8String(try_catch.Exception());
+      complete(req, err.empty() ? "Read failed" : err);
+    }
+  }
+}
+
+NAN_METHOD(VSIJS::readCallback) {
+  Nan::HandleScope scope;
+
+  auto it = pending.find(Nan::To<uint32_t>(info.Data()).ToChecked());
+  // called more than once
+  if (it == pending.end()) return;
+  Request *req = it->second;
+  pending.erase(it);
+
+  if (info.Length() > 0 && !info[0]->IsNull() && !info[0]->IsUndefined()) {
+    Local<Value> message = info[0];
+    if (info[0]->IsObject()) {
+      Local<Value> prop = Nan::Get(info[0].As<Object>(), Nan::New("message").ToLocalChecked()).ToLocalChecked();
+      if (!prop->IsUndefined()) message = prop;
+    }
+    std::string err = *Nan::Utf8String(message);
+    complete(req, err.empty() ? "Read failed" : err);
+    return;
+  }
+  if (info.Length() < 2 || !info[1]->IsArrayBufferView()) {
+    complete(req, "The reader must return a Buffer or a TypedArray");
+    return;
+  }
+  Local<ArrayBufferView> view = info[1].As<ArrayBufferView>();
+  if (view->ByteLength() < req->len) {
+    complete(req, "The reader returned less data than requested");
+    return;
+  }
+  view->CopyContents(req->dest, req->len);
+  complete(req, "");
+}
+
+VSIJS::Block VSIJS::cacheGet(unsigned int file_id, vsi_l_offset block) {
+  Block r;
+  uv_mutex_lock(&cache_lock);
+  auto it = cache_index.find(BlockKey(file_id, block));
+  if (it != cache_index.end()) {
+    cache.splice(cache.begin(), cache, it->second);
+    r = it->second->second;
+  }
+  uv_mutex_unlock(&cache_lock);
+  return r;
+}
+
+void VSIJS::cachePut(unsigned int file_id, vsi_l_offset block, const Block &data) {
+  BlockKey key(file_id, block);
+  uv_mutex_lock(&cache_lock);
+  auto it = cache_index.find(key);
+  if (it != cache_index.end()) {
+    cache_bytes -= it->second->second->size();
+    cache.erase(it->second);
+  }
+  cache.emplace_front(key, data);
+  cache_index[key] = cache.begin();
+  cache_bytes += data->size();
+  cacheEvict();
+  uv_mutex_unlock(&cache_lock);
+}
+
+// must be called with the cache lock held
+void VSIJS::cacheEvict() {
+  while (cache_bytes > cache_max && !cache.empty()) {
+    cache_bytes -= cache.back().second->size();
+    cache_index.erase(cache.back().first);
+    cache.pop_back();
+  }
+}
+
+void VSIJS::cachePurge(unsigned int file_id) {
+  uv_mutex_lock(&cache_lock);
+  for (auto it = cache.begin(); it != cache.end();) {
+    if (it->first.first == file_id) {
+      cache_bytes -= it->second->size();
+      cache_index.erase(it->first);
+      it = cache.erase(it);
+    } else
+      it++;
+  }
+  uv_mutex_unlock(&cache_lock);
+}
+
+/**
+ * A virtual filesystem (`/vsijs/`) whose files are read by JS functions.
+ *
+ * GDAL reads only the byte ranges it needs, allowing to open a Cloud Optimized
+ * GeoTIFF or a GeoPackage stored behind any storage client without
+ * downloading it. The data is read in blocks that are kept in a cache shared
+ * by all the files, sequential reads also read the following blocks in
+ * advance.
+ *
+ * The reader is called on the main thread while GDAL waits on a worker
+ * thread, so only the asynchronous methods (`gdal.openAsync()`,
+ * `pixels.readAsync()`, ...) can read data that is not already cached.
+ * Closing a dataset fails its pending reads, the other synchronous methods
+ * must not be called on a dataset with pending asynchronous operations as
+ * the event loop would be blocked.
+ *
+ * @class gdal.vsijs
+ */
+
+/**
+ * Registers a new file.
+ *
+ * ```
+ * gdal.vsijs.register('remote.tif', size, (offset, length) =>
+ *   client.getRange(key, offset, length))
+ * const ds = await gdal.openAsync('/vsijs/remote.tif')```
+ *
+ * @static
+ * @method register
+ * @throws Error
+ * @param {String} name The file name in `/vsijs/`
+ * @param {Number} size The file size in bytes
+ * @param {Function} read `(offset, length) => Promise<Buffer>`, the Buffer (or
+ * TypedArray) must contain at least `length` bytes, may also return a Buffer
+ * synchronously
+ * @param {Object} [options]
+ * @param {Number} [options.blockSize=65536] The size of the cached blocks
+ * @param {Number} [options.readAhead=2] Number of blocks read in advance by
+ * sequential reads
+ * @return {String} The full file name
+ */
+NAN_METHOD(VSIJS::registerFile) {
+  Nan::HandleScope scope;
+  std::string name;
+  double size;
+  int block_size = default_block_size;
+  int read_ahead = default_read_ahead;
+
+  NODE_ARG_STR(0, "name", name);
+  NODE_ARG_DOUBLE(1, "size", size);
+  if (info.Length() < 3 || !info[2]->IsFunction()) {
+    Nan::ThrowTypeError("read must be a function");
+    return;
+  }
+  NODE_ARG_INT_OPT(3, "blockSize", block_size);
+  NODE_ARG_INT_OPT(4, "readAhead", read_ahead);
+
+  if (name.empty()) {
+    Nan::ThrowError("name must not be empty");
+    return;
+  }
+  if (size < 0) {
+    Nan::ThrowRangeError("size must not be negative");
+    return;
+  }
+  if (block_size <= 0) {
+    Nan::ThrowRangeError("blockSize must be positive");
+    return;
+  }
+  if (read_ahead < 0) {
+    Nan::ThrowRangeError("readAhead must not be negative");
+    return;
+  }
+
+  uv_mutex_lock(&files_lock);
+  bool exists = files.count(name) > 0;
+  if (!exists)
+    files[name] = std::make_shared<VSIJSFile>(
+      ++last_id, static_cast<vsi_l_offset>(size), block_size, read_ahead, info[2].As<Function>());
+  uv_mutex_unlock(&files_lock);
+
+  if (exists) {
+    Nan::ThrowError("File already exists");
+    return;
+  }
+  info.GetReturnValue().Set(Nan::New<String>(prefix + name).ToLocalChecked());
+}
+
+/**
+ * Unregisters a file and drops its cached blocks. The open datasets fail
+ * to read the blocks that are not cached anymore.
+ *
+ * @static
+ * @method unregister
+ * @param {String} name The file name in `/vsijs/`
+ * @return {Boolean} `false` if there was no such file
+ */
+NAN_METHOD(VSIJS::unregisterFile) {
+  Nan::HandleScope scope;
+  std::string name;
+
+  NODE_ARG_STR(0, "name", name);
+
+  uv_mutex_lock(&files_lock);
+  auto it = files.find(name);
+  std::shared_ptr<VSIJSFile> file = it != files.end() ? it->second : nullptr;
+  if (file != nullptr) files.erase(it);
+  uv_mutex_unlock(&files_lock);
+
+  if (file == nullptr) {
+    info.GetReturnValue().Set(Nan::False());
+    return;
+  }
+  delete file->reader;
+  file->reader = nullptr;
+  cachePurge(file->id);
+  info.GetReturnValue().Set(Nan::True());
+}
+
+/**
+ * Sets the size of the block cache shared by all the `/vsijs/` files.
+ *
+ * @static
+ * @method setCacheSize
+ * @param {Number} bytes Defaults to 16MB, `0` disables the cache
+ */
+NAN_METHOD(VSIJS::setCacheSize) {
+  Nan::HandleScope scope;
+  double bytes;
+
+  NODE_ARG_DOUBLE(0, "bytes", bytes);
+  if (bytes < 0) {
+    Nan::ThrowRangeError("bytes must not be negative");
+    return;
+  }
+
+  uv_mutex_lock(&cache_lock);
+  cache_max = static_cast<size_t>(bytes);
+  cacheEvict();
+  uv_mutex_unlock(&cache_lock);
+}
+
+} // namespace node_gdal
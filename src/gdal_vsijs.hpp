@@ -0,0 +1,162 @@
+#ifndef __NODE_GDAL_VSIJS_H__
+#define __NODE_GDAL_VSIJS_H__
+
+#include <deque>
+#include <list>
+#include <map>
+#include <memory>
+#include <string>
+#include <vector>
+
+// node
+#include <node.h>
+#include <uv.h>
+
+// nan
+#include "nan-wrapper.h"
+
+// gdal
+#include <cpl_vsi_virtual.h>
+#include <gdal_priv.h>
+
+#include "async/async_lock.hpp"
+
+using namespace v8;
+
+namespace node_gdal {
+
+/**
+ * A /vsijs/ file, its content is read by a JS function
+ *
+ * The file is shared by the registry and the open handles, so that it
+ * can be unregistered while GDAL still uses it. reader must only be
+ * accessed on the main thread, it is deleted when the file is unregistered
+ */
+struct VSIJSFile {
+  const unsigned int id;
+  const vsi_l_offset size;
+  const size_t block_size;
+  const unsigned int read_ahead;
+  Nan::Callback *reader;
+
+  VSIJSFile(unsigned int id, vsi_l_offset size, size_t block_size, unsigned int read_ahead, Local<Function> reader);
+};
+
+class VSIJSHandle : public VSIVirtualHandle {
+    public:
+  explicit VSIJSHandle(const std::shared_ptr<VSIJSFile> &file);
+
+  int Seek(vsi_l_offset offset, int whence) override;
+  vsi_l_offset Tell() override;
+  size_t Read(void *buffer, size_t size, size_t count) override;
+  size_t Write(const void *buffer, size_t size, size_t count) override;
+  int Eof() override;
+  int Close() override;
+
+    private:
+  std::shared_ptr<VSIJSFile> file;
+  vsi_l_offset offset;
+  // end of the previous read, a read starting there is sequential and triggers the read-ahead
+  vsi_l_offset last_end;
+  bool eof;
+};
+
+class VSIJSFilesystemHandler : public VSIFilesystemHandler {
+    public:
+  VSIVirtualHandle *Open(const char *filename, const char *access, bool set_error) override;
+  int Stat(const char *filename, VSIStatBufL *stat, int flags) override;
+};
+
+/**
+ * The /vsijs/ filesystem
+ *
+ * GDAL calls the handler on the thread that runs the operation. The JS
+ * reader can only be called on the main thread, so the GDAL thread queues
+ * a request, wakes up the event loop with an uv_async_t and waits until
+ * the JS callback has delivered the data. GDAL operations on the main
+ * thread cannot wait for the event loop and can only use cached blocks.
+ *
+ * A request remembers the datasets used by its job (AsyncLock::current),
+ * closing one of them fails the request instead of waiting for the JS
+ * callback, which could never run while the main thread waits for the job
+ *
+ * The blocks are kept in a cache shared by all files, a cache miss reads
+ * all the missing blocks of the request in one call and, when the reads
+ * are sequential, read_ahead more blocks
+ */
+class VSIJS {
+    public:
+  typedef std::shared_ptr<std::vector<GByte>> Block;
+
+  static void Initialize(Local<Object> target);
+  static NAN_METHOD(registerFile);
+  static NAN_METHOD(unregisterFile);
+  static NAN_METHOD(setCacheSize);
+
+  static std::shared_ptr<VSIJSFile> find(const std::string &name);
+  // Returns a cached block or an empty pointer
+  static Block cacheGet(unsigned int file_id, vsi_l_offset block);
+  // Reads count blocks starting at first, copies the len bytes at offset,
+  // which must be within these blocks, to dest and puts the blocks in the cache
+  // Returns an error message or an empty string
+  static std::string load(
+    const std::shared_ptr<VSIJSFile> &file,
+    vsi_l_offset first,
+    vsi_l_offset count,
+    vsi_l_offset offset,
+    size_t len,
+    GByte *dest);
+  // Fails the requests of the jobs using this lock, main thread only
+  static void cancel(AsyncLock *lock);
+
+    private:
+  struct Request {
+    std::shared_ptr<VSIJSFile> file;
+    vsi_l_offset offset;
+    size_t len;
+    GByte *dest;
+    std::string error;
+    bool done;
+    uv_cond_t cond;
+    std::vector<AsyncLock *> locks;
+  };
+
+  typedef std::pair<unsigned int, vsi_l_offset> BlockKey;
+  typedef std::list<std::pair<BlockKey, Block>> BlockList;
+
+  // Blocks the calling thread until the main thread has read the data
+  static std::string fetch(const std::shared_ptr<VSIJSFile> &file, vsi_l_offset offset, size_t len, GByte *dest);
+  static void complete(Request *req, const std::string &error);
+  // must be called with the queue lock held
+  static void completeLocked(Request *req, const std::string &error);
+  static void dispatch(uv_async_t *handle);
+  static NAN_METHOD(readCallback);
+  static void cachePut(unsigned int file_id, vsi_l_offset block, const Block &data);
+  static void cacheEvict();
+  static void cachePurge(unsigned int file_id);
+
+  static uv_thread_t main_thread;
+  static uv_async_t *async;
+
+  // protects the registry
+  static uv_mutex_t files_lock;
+  static std::map<std::string, std::shared_ptr<VSIJSFile>> files;
+  static unsigned int last_id;
+
+  // protects the queue and the requests
+  static uv_mutex_t queue_lock;
+  static std::deque<Request *> queue;
+  // main thread only, the requests waiting for their JS callback
+  static std::map<unsigned int, Request *> pending;
+  static unsigned int last_request;
+
+  // protects the cache, most recently used first
+  static uv_mutex_t cache_lock;
+  static BlockList cache;
+  static std::map<BlockKey, BlockList::iterator> cache_index;
+  static size_t cache_bytes;
+  static size_t cache_max;
+};
+
+} // namespace node_gdal
+#endif
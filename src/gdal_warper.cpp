@@ -1,4 +1,5 @@
 #include "gdal_warper.hpp"
+#include "async/async_lock.hpp"
 #include "gdal_common.hpp"
 #include "gdal_dataset.hpp"
 #include "gdal_spatial_reference.hpp"
@@ -8,6 +9,7 @@ namespace node_gdal {
 
 void Warper::Initialize(Local<Object> target) {
   Nan::SetMethod(target, "reprojectImage", reprojectImage);
+  Nan::SetMethod(target, "reprojectImageAsync", reprojectImageAsync);
   Nan::SetMethod(target, "suggestedWarpOutput", suggestedWarpOutput);
 }
 
@@ -188,35 +190,63 @@ CPLErr GDALReprojectImageMulti(
  * @param {Integer} [options.memoryLimit]
  * @param {Number} [options.maxError]
  * @param {Boolean} [options.multi]
+ * @param {Integer|string} [options.threads] Number of worker threads of the
+ * warp kernel or `"ALL_CPUS"`, sets the `NUM_THREADS` warp option
  * @param {string[]|object} [options.options] Warp options (see:
  * [reference](http://www.gdal.org/structGDALWarpOptions.html#a0ed77f9917bb96c7a9aabd73d4d06e08))
  */
-NAN_METHOD(Warper::reprojectImage) {
+
+/**
+ * Asynchronously reprojects a dataset.
+ * If the last parameter is a callback, then this callback is called on completion and undefined is returned.
+ * Otherwise the function returns a Promise resolved with the result.
+ *
+ * The source and destination datasets are locked during the operation.
+ *
+ * @throws Error
+ * @method reprojectImageAsync
+ * @static
+ * @for gdal
+ * @param {object} options Same options as {{#crossLink "gdal/reprojectImage:method"}}reprojectImage(){{/crossLink}}
+ * @param {gdal.Dataset} options.src
+ * @param {gdal.Dataset} options.dst
+ * @param {gdal.SpatialReference} options.s_srs
+ * @param {gdal.SpatialReference} options.t_srs
+ * @param {Integer|string} [options.threads] Number of worker threads of the
+ * warp kernel or `"ALL_CPUS"`, sets the `NUM_THREADS` warp option
+ * @param {Function} [options.progress_cb] Progress callback, called with the completion ratio
+ * @param {AbortSignal} [options.signal] Aborts the operation
+ * @param {requestCallback} [callback] Promisifiable callback, always the last parameter
+ * @return {Promise<void>}
+ */
+GDAL_ASYNCABLE_DEFINE(Warper::reprojectImage) {
   Nan::HandleScope scope;
 
   Local<Object> obj;
   Local<Value> prop;
 
-  WarpOptions options;
+  std::shared_ptr<WarpOptions> options(new WarpOptions());
   GDALWarpOptions *opts;
-  std::string s_srs_str;
-  std::string t_srs_str;
+  Dataset *src;
+  Dataset *dst;
   SpatialReference *s_srs;
   SpatialReference *t_srs;
   double maxError = 0;
 
   NODE_ARG_OBJECT(0, "Warp options", obj);
 
-  if (options.parse(obj)) {
+  if (options->parse(obj)) {
     return; // error parsing options object
   } else {
-    opts = options.get();
+    opts = options->get();
   }
   if (!opts->hDstDS) {
     Nan::ThrowTypeError("dst Dataset must be provided");
     return;
   }
 
+  NODE_WRAPPED_FROM_OBJ(obj, "src", Dataset, src);
+  NODE_WRAPPED_FROM_OBJ(obj, "dst", Dataset, dst);
   NODE_WRAPPED_FROM_OBJ(obj, "s_srs", SpatialReference, s_srs);
   NODE_WRAPPED_FROM_OBJ(obj, "t_srs", SpatialReference, t_srs);
   NODE_DOUBLE_FROM_OBJ_OPT(obj, "maxError", maxError);
@@ -231,44 +261,55 @@ NAN_METHOD(Warper::reprojectImage) {
     Nan::ThrowError("Error converting t_srs to WKT");
     return;
   }
-
-  CPLErr err;
-
-  if (options.useMultithreading()) {
-    err = GDALReprojectImageMulti(
-      opts->hSrcDS,
-      s_srs_wkt,
-      opts->hDstDS,
-      t_srs_wkt,
-      opts->eResampleAlg,
-      opts->dfWarpMemoryLimit,
-      maxError,
-      NULL,
-      NULL,
-      opts);
-  } else {
-    err = GDALReprojectImage(
-      opts->hSrcDS,
-      s_srs_wkt,
-      opts->hDstDS,
-      t_srs_wkt,
-      opts->eResampleAlg,
-      opts->dfWarpMemoryLimit,
-      maxError,
-      NULL,
-      NULL,
-      opts);
-  }
-
+  std::string s_wkt(s_srs_wkt), t_wkt(t_srs_wkt);
   CPLFree(s_srs_wkt);
   CPLFree(t_srs_wkt);
 
-  if (err) {
-    NODE_THROW_CPLERR(err);
-    return;
-  }
-
-  return;
+  GDALAsyncableJob<CPLErr> job;
+  if (async && !AsyncProgress::parse(info, 1, job.progress)) return;
+  job.persist(src->handle());
+  job.persist(dst->handle());
+  // the cutline geometry is used by reference
+  prop = Nan::Get(obj, Nan::New("cutline").ToLocalChecked()).ToLocalChecked();
+  if (opts->hCutline) job.persist(prop.As<Object>());
+
+  AsyncLockRef src_lock = src->async_lock;
+  AsyncLockRef dst_lock = dst->async_lock;
+  AsyncProgress *progress = job.progress;
+  job.main = [options, src_lock, dst_lock, s_wkt, t_wkt, maxError, progress]() {
+    GDALWarpOptions *opts = options->get();
+    AsyncLockGuard lock({src_lock, dst_lock});
+    CPLErr err;
+    if (options->useMultithreading()) {
+      err = GDALReprojectImageMulti(
+        opts->hSrcDS,
+        s_wkt.c_str(),
+        opts->hDstDS,
+        t_wkt.c_str(),
+        opts->eResampleAlg,
+        opts->dfWarpMemoryLimit,
+        maxError,
+        progress ? AsyncProgress::progress : NULL,
+        progress,
+        opts);
+    } else {
+      err = GDALReprojectImage(
+        opts->hSrcDS,
+        s_wkt.c_str(),
+        opts->hDstDS,
+        t_wkt.c_str(),
+        opts->eResampleAlg,
+        opts->dfWarpMemoryLimit,
+        maxError,
+        progress ? AsyncProgress::progress : NULL,
+        progress,
+        opts);
+    }
+    if (err != CE_None) throw CPLGetLastErrorMsg();
+    return err;
+  };
+  job.rval = [](CPLErr) -> Local<Value> { return Nan::Undefined(); };
+  job.run(info, async, 3);
 }
 
 /**
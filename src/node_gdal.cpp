@@ -57,13 +57,16 @@
 #include "gdal_polygon.hpp"
 #include "gdal_spatial_reference.hpp"
 #include "gdal_memfile.hpp"
+#include "gdal_vsijs.hpp"
 
+#include "async/thread_pool.hpp"
 #include "gdal.hpp"
 #include "utils/field_types.hpp"
 
 // collections
 #include "collections/dataset_bands.hpp"
 #include "collections/dataset_layers.hpp"
+#include "collections/dataset_pixels.hpp"
 #include "collections/feature_defn_fields.hpp"
 #include "collections/feature_fields.hpp"
 #include "collections/gdal_drivers.hpp"
@@ -215,6 +218,50 @@ static NAN_METHOD(setPROJSearchPath) {
 #endif
 }
 
+/**
+ * Set the number of threads used by all asynchronous operations.
+ *
+ * node-gdal uses its own pool of threads, separate from the libuv thread pool,
+ * so that slow GDAL operations do not starve the rest of Node.js.
+ * The default size is 4.
+ *
+ * @for gdal
+ * @static
+ * @method setThreadPoolSize
+ * @param {Integer} size number of threads, at least 1
+ */
+static NAN_METHOD(setThreadPoolSize) {
+  Nan::HandleScope scope;
+  int size;
+
+  NODE_ARG_INT(0, "size", size);
+  if (size < 1) {
+    Nan::ThrowRangeError("Thread pool size must be at least 1");
+    return;
+  }
+
+  thread_pool.resize(size);
+}
+
+/**
+ * Returns the state of the thread pool used by all asynchronous operations.
+ *
+ * @for gdal
+ * @static
+ * @method getThreadPoolStats
+ * @return {Object} `{size, busy, queued}`: number of threads, threads currently running a job and jobs waiting for a
+ * thread
+ */
+static NAN_METHOD(getThreadPoolStats) {
+  Nan::HandleScope scope;
+
+  Local<Object> result = Nan::New<Object>();
+  Nan::Set(result, Nan::New("size").ToLocalChecked(), Nan::New(thread_pool.size()));
+  Nan::Set(result, Nan::New("busy").ToLocalChecked(), Nan::New(thread_pool.busy()));
+  Nan::Set(result, Nan::New("queued").ToLocalChecked(), Nan::New(thread_pool.queued()));
+  info.GetReturnValue().Set(result);
+}
+
 static NAN_METHOD(ThrowDummyCPLError) {
   CPLError(CE_Failure, CPLE_AppDefined, "Mock error");
   return;
@@ -250,12 +297,16 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
   Nan::SetMethod(target, "getConfigOption", getConfigOption);
   Nan::SetMethod(target, "decToDMS", decToDMS);
   Nan::SetMethod(target, "setPROJSearchPath", setPROJSearchPath);
+  Nan::SetMethod(target, "setThreadPoolSize", setThreadPoolSize);
+  Nan::SetMethod(target, "getThreadPoolStats", getThreadPoolStats);
   Nan::SetMethod(target, "_triggerCPLError", ThrowDummyCPLError); // for tests
   Nan::SetMethod(target, "_isAlive", isAlive);                    // for tests
   Nan::SetMethod(target, "_getMemFileName", getMemfileName);      // not a public API
 
   Warper::Initialize(target);
   Algorithms::Initialize(target);
+  Memfile::Initialize(target);
+  VSIJS::Initialize(target);
 
   Driver::Initialize(target);
   Dataset::Initialize(target);
@@ -278,6 +329,7 @@ static void Init(Local<Object> target, Local<v8::Value>, void *) {
   CoordinateTransformation::Initialize(target);
 
   DatasetBands::Initialize(target);
+  DatasetPixels::Initialize(target);
   DatasetLayers::Initialize(target);
   LayerFeatures::Initialize(target);
   FeatureFields::Initialize(target);
@@ -0,0 +1,172 @@
+#include "coordinates.hpp"
+#include "typed_array.hpp"
+
+#include <string>
+
+namespace node_gdal {
+
+namespace Coordinates {
+
+static bool count(OGRGeometry *geom, int &curves, int &points) {
+  switch (wkbFlatten(geom->getGeometryType())) {
+    case wkbPoint:
+      curves++;
+      if (!geom->IsEmpty()) points++;
+      return true;
+    case wkbLineString:
+    case wkbLinearRing:
+      curves++;
+      points += static_cast<OGRLineString *>(geom)->getNumPoints();
+      return true;
+    case wkbPolygon: {
+      OGRPolygon *polygon = static_cast<OGRPolygon *>(geom);
+      if (polygon->getExteriorRing() == nullptr) return true;
+      if (!count(polygon->getExteriorRing(), curves, points)) return false;
+      for (int i = 0; i < polygon->getNumInteriorRings(); i++) {
+        if (!count(polygon->getInteriorRing(i), curves, points)) return false;
+      }
+      return true;
+    }
+    case wkbMultiPoint:
+    case wkbMultiLineString:
+    case wkbMultiPolygon:
+    case wkbGeometryCollection: {
+      OGRGeometryCollection *collection = static_cast<OGRGeometryCollection *>(geom);
+      for (int i = 0; i < collection->getNumGeometries(); i++) {
+        if (!count(collection->getGeometryRef(i), curves, points)) return false;
+      }
+      return true;
+    }
+    default:
+      Nan::ThrowError((std::string("Unsupported geometry type: ") + geom->getGeometryName()).c_str());
+      return false;
+  }
+}
+
+// count() has validated the geometry types
+static void write(OGRGeometry *geom, int dims, double *coords, int32_t *offsets, int &curve, int &point) {
+  switch (wkbFlatten(geom->getGeometryType())) {
+    case wkbPoint: {
+      OGRPoint *pt = static_cast<OGRPoint *>(geom);
+      offsets[curve++] = point;
+      if (pt->IsEmpty()) return;
+      double *dst = coords + static_cast<size_t>(point) * dims;
+      dst[0] = pt->getX();
+      dst[1] = pt->getY();
+      if (dims > 2) dst[2] = pt->getZ();
+      point++;
+      return;
+    }
+    case wkbLineString:
+    case wkbLinearRing: {
+      OGRLineString *line = static_cast<OGRLineString *>(geom);
+      offsets[curve++] = point;
+      double *dst = coords + static_cast<size_t>(point) * dims;
+      int stride = dims * sizeof(double);
+      line->getPoints(dst, stride, dst + 1, stride, dims > 2 ? dst + 2 : nullptr, stride);
+      point += line->getNumPoints();
+      return;
+    }
+    case wkbPolygon: {
+      OGRPolygon *polygon = static_cast<OGRPolygon *>(geom);
+      if (polygon->getExteriorRing() == nullptr) return;
+      write(polygon->getExteriorRing(), dims, coords, offsets, curve, point);
+      for (int i = 0; i < polygon->getNumInteriorRings(); i++) {
+        write(polygon->getInteriorRing(i), dims, coords, offsets, curve, point);
+      }
+      return;
+    }
+    default: {
+      OGRGeometryCollection *collection = static_cast<OGRGeometryCollection *>(geom);
+      for (int i = 0; i < collection->getNumGeometries(); i++) {
+        write(collection->getGeometryRef(i), dims, coords, offsets, curve, point);
+      }
+      return;
+    }
+  }
+}
+
+bool Export(OGRGeometry *geom, int dims, Local<Value> *coordinates, Local<Value> *offsets, Local<Value> *parts) {
+  int curves = 0, points = 0;
+  if (!count(geom, curves, points)) return false;
+
+  *coordinates = TypedArray::New(GDT_Float64, static_cast<unsigned int>(points) * dims);
+  if (!(*coordinates)->IsObject()) return false; // TypedArray::New threw an error
+  Local<Value> offsets_array = TypedArray::New(GDT_Int32, curves + 1);
+  if (!offsets_array->IsObject()) return false;
+
+  Nan::TypedArrayContents<double> coords_data(*coordinates);
+  Nan::TypedArrayContents<int32_t> offsets_data(offsets_array);
+
+  int curve = 0, point = 0;
+  if (parts != nullptr) {
+    OGRGeometryCollection *collection = static_cast<OGRGeometryCollection *>(geom);
+    int n = collection->getNumGeometries();
+    *parts = TypedArray::New(GDT_Int32, n + 1);
+    if (!(*parts)->IsObject()) return false;
+    Nan::TypedArrayContents<int32_t> parts_data(*parts);
+    for (int i = 0; i < n; i++) {
+      (*parts_data)[i] = curve;
+      write(collection->getGeometryRef(i), dims, *coords_data, *offsets_data, curve, point);
+    }
+    (*parts_data)[n] = curve;
+  } else {
+    write(geom, dims, *coords_data, *offsets_data, curve, point);
+  }
+  (*offsets_data)[curves] = points;
+
+  if (offsets != nullptr) *offsets = offsets_array;
+  return true;
+}
+
+bool ValidateCoordinates(Local<Value> array, int dims, const double *&data, int &count) {
+  if (!array->IsFloat64Array()) {
+    Nan::ThrowTypeError("coordinates must be a Float64Array");
+    return false;
+  }
+  Nan::TypedArrayContents<double> contents(array);
+  if (contents.length() % dims != 0) {
+    Nan::ThrowRangeError("coordinates length must be a multiple of the number of dimensions");
+    return false;
+  }
+  count = static_cast<int>(contents.length() / dims);
+  data = *contents;
+  return true;
+}
+
+// Offsets must start at 0, never decrease and end at last
+bool ValidateOffsets(Local<Value> array, const char *name, int last, const int32_t *&data, int &count) {
+  if (!array->IsInt32Array()) {
+    Nan::ThrowTypeError((std::string(name) + " must be an Int32Array").c_str());
+    return false;
+  }
+  Nan::TypedArrayContents<int32_t> contents(array);
+  int n = static_cast<int>(contents.length());
+  if (n < 1 || (*contents)[0] != 0 || (*contents)[n - 1] != last) {
+    Nan::ThrowRangeError((std::string(name) + " must start at 0 and end at " + std::to_string(last)).c_str());
+    return false;
+  }
+  for (int i = 1; i < n; i++) {
+    if ((*contents)[i] < (*contents)[i - 1]) {
+      Nan::ThrowRangeError((std::string(name) + " must not decrease").c_str());
+      return false;
+    }
+  }
+  count = n - 1;
+  data = *contents;
+  return true;
+}
+
+void SetCurve(OGRLineString *line, const double *coords, int count, int dims) {
+  if (dims == 2) {
+    // OGRRawPoint is {x, y}, the layout of interleaved 2D coordinates
+    line->setPoints(count, reinterpret_cast<OGRRawPoint *>(const_cast<double *>(coords)));
+    return;
+  }
+  line->setNumPoints(count, FALSE);
+  for (int i = 0; i < count; i++) line->setPoint(i, coords[3 * i], coords[3 * i + 1], coords[3 * i + 2]);
+}
+
+} // namespace Coordinates
+
+} // namespace node_gdal
@@ -0,0 +1,38 @@
+#ifndef __NODE_GDAL_COORDINATES_H__
+#define __NODE_GDAL_COORDINATES_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+using namespace v8;
+
+namespace node_gdal {
+
+// Bulk vertex access: the vertices of all the curves of a geometry as one
+// Float64Array of interleaved x, y[, z]
+//
+// offsets: Int32Array, the index of the first vertex of each curve (rings
+// and linestrings, a point is a curve of one vertex) followed by the total
+// number of vertices
+// parts: Int32Array, the index of the first curve of each child of a
+// collection followed by the total number of curves
+
+namespace Coordinates {
+
+// Throws a JS error and returns false on unsupported geometries,
+// offsets and parts can be null
+bool Export(OGRGeometry *geom, int dims, Local<Value> *coordinates, Local<Value> *offsets, Local<Value> *parts);
+// Throw a JS error and return false on invalid arrays
+bool ValidateCoordinates(Local<Value> array, int dims, const double *&data, int &count);
+bool ValidateOffsets(Local<Value> array, const char *name, int last, const int32_t *&data, int &count);
+void SetCurve(OGRLineString *line, const double *coords, int count, int dims);
+} // namespace Coordinates
+
+} // namespace node_gdal
+#endif
@@ -0,0 +1,73 @@
+#include "dataset_pool.hpp"
+
+namespace node_gdal {
+
+DatasetPool::DatasetPool(const std::string &path, unsigned int flags, unsigned int size)
+  : path(path), flags(flags), size(size), free(), opened(0), closed(false) {
+  uv_mutex_init(&lock);
+  uv_cond_init(&cond);
+}
+
+DatasetPool::~DatasetPool() {
+  close();
+  uv_cond_destroy(&cond);
+  uv_mutex_destroy(&lock);
+}
+
+GDALDataset *DatasetPool::acquire() {
+  uv_mutex_lock(&lock);
+  while (!closed && free.empty() && opened >= size) uv_cond_wait(&cond, &lock);
+  if (closed) {
+    uv_mutex_unlock(&lock);
+    return nullptr;
+  }
+  if (!free.empty()) {
+    GDALDataset *ds = free.back();
+    free.pop_back();
+    uv_mutex_unlock(&lock);
+    return ds;
+  }
+
+  // open a new handle without holding the lock, opening can be slow
+  opened++;
+  uv_mutex_unlock(&lock);
+#if GDAL_VERSION_MAJOR < 2
+  GDALDataset *ds = static_cast<GDALDataset *>(GDALOpen(path.c_str(), GA_ReadOnly));
+#else
+  GDALDataset *ds = static_cast<GDALDataset *>(GDALOpenEx(path.c_str(), flags, NULL, NULL, NULL));
+#endif
+  if (ds == nullptr) {
+    uv_mutex_lock(&lock);
+    opened--;
+    uv_cond_broadcast(&cond);
+    uv_mutex_unlock(&lock);
+  }
+  return ds;
+}
+
+void DatasetPool::release(GDALDataset *ds) {
+  uv_mutex_lock(&lock);
+  free.push_back(ds);
+  uv_cond_broadcast(&cond);
+  uv_mutex_unlock(&lock);
+}
+
+void DatasetPool::close() {
+  uv_mutex_lock(&lock);
+  closed = true;
+  uv_cond_broadcast(&cond);
+  while (free.size() < opened) uv_cond_wait(&cond, &lock);
+  for (GDALDataset *ds : free) GDALClose(ds);
+  free.clear();
+  opened = 0;
+  uv_mutex_unlock(&lock);
+}
+
+bool DatasetPool::isClosed() {
+  uv_mutex_lock(&lock);
+  bool r = closed;
+  uv_mutex_unlock(&lock);
+  return r;
+}
+
+} // namespace node_gdal
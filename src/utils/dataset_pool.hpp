@@ -0,0 +1,55 @@
+#ifndef __DATASET_POOL_H__
+#define __DATASET_POOL_H__
+
+#include <memory>
+#include <string>
+#include <vector>
+
+// node
+#include <uv.h>
+
+// gdal
+#include <gdal_priv.h>
+
+namespace node_gdal {
+
+/**
+ * A pool of independent read-only handles on the same file
+ *
+ * GDALDataset objects are not thread-safe, so all async operations on a
+ * Dataset are serialized on its async_lock. Async reads on a pooled
+ * Dataset instead borrow one of these handles and can run in parallel.
+ *
+ * The handles are opened lazily (from the worker threads) up to the
+ * configured size. The pool is shared by the Dataset, its bands and
+ * the running jobs, so that close() can be called while jobs are queued.
+ */
+class DatasetPool {
+    public:
+  DatasetPool(const std::string &path, unsigned int flags, unsigned int size);
+  ~DatasetPool();
+
+  // Returns a free handle, blocks if all of them are in use
+  // Returns nullptr if the pool is closed or the file cannot be opened
+  GDALDataset *acquire();
+  void release(GDALDataset *ds);
+  // Waits for the handles in use and closes all handles
+  void close();
+  // Tells a nullptr from acquire() caused by close() from an open error
+  bool isClosed();
+
+    private:
+  std::string path;
+  unsigned int flags;
+  unsigned int size;
+  uv_mutex_t lock;
+  uv_cond_t cond;
+  std::vector<GDALDataset *> free;
+  unsigned int opened;
+  bool closed;
+};
+
+typedef std::shared_ptr<DatasetPool> DatasetPoolRef;
+
+} // namespace node_gdal
+#endif
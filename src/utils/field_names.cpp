@@ -0,0 +1,80 @@
+#include "field_names.hpp"
+
+#include <algorithm>
+#include <cctype>
+#include <cstring>
+
+namespace node_gdal {
+
+// Entries of deleted definitions are only dropped when the cache is full
+static const size_t max_cached_defns = 256;
+
+std::map<OGRFeatureDefn *, std::unique_ptr<FieldNames>> *FieldNames::cache =
+  new std::map<OGRFeatureDefn *, std::unique_ptr<FieldNames>>();
+
+static std::string lowercase(std::string str) {
+  std::transform(str.begin(), str.end(), str.begin(), [](unsigned char c) { return std::tolower(c); });
+  return str;
+}
+
+FieldNames::FieldNames(OGRFeatureDefn *defn) : names(), keys(), indices(), first() {
+  int n = defn->GetFieldCount();
+  names.reserve(n);
+  keys.resize(n);
+  for (int i = 0; i < n; i++) {
+    const char *name = defn->GetFieldDefn(i)->GetNameRef();
+    names.push_back(name);
+    keys[i].Reset(String::NewFromUtf8(v8::Isolate::GetCurrent(), name, NewStringType::kInternalized).ToLocalChecked());
+    // emplace keeps the first field with a given name
+    first.push_back(indices.emplace(lowercase(name), i).first->second);
+  }
+}
+
+// The copyable persistent handles are not reset by their own destructor
+FieldNames::~FieldNames() {
+  for (auto &key : keys) key.Reset();
+}
+
+bool FieldNames::matches(OGRFeatureDefn *defn) {
+  if (defn->GetFieldCount() != count()) return false;
+  for (int i = 0; i < count(); i++) {
+    if (strcmp(defn->GetFieldDefn(i)->GetNameRef(), names[i].c_str()) != 0) return false;
+  }
+  return true;
+}
+
+FieldNames *FieldNames::get(OGRFeatureDefn *defn) {
+  auto it = cache->find(defn);
+  if (it != cache->end()) {
+    if (it->second->matches(defn)) return it->second.get();
+    cache->erase(it);
+  }
+  if (cache->size() >= max_cached_defns) cache->clear();
+
+  FieldNames *names = new FieldNames(defn);
+  (*cache)[defn] = std::unique_ptr<FieldNames>(names);
+  return names;
+}
+
+Local<String> FieldNames::name(int i) {
+  return Nan::New(keys[i]);
+}
+
+void FieldNames::copy(std::vector<Local<String>> &keys, std::vector<int> &indices) {
+  keys.clear();
+  indices.clear();
+  keys.reserve(count());
+  indices.reserve(count());
+  for (int i = 0; i < count(); i++) {
+    keys.push_back(name(i));
+    indices.push_back(indexOf(i));
+  }
+}
+
+int FieldNames::index(std::string name) {
+  auto it = indices.find(lowercase(name));
+  if (it == indices.end()) return -1;
+  return it->second;
+}
+
+} // namespace node_gdal
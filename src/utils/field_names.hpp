@@ -0,0 +1,69 @@
+#ifndef __NODE_GDAL_FIELD_NAMES_H__
+#define __NODE_GDAL_FIELD_NAMES_H__
+
+#include <map>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// node
+#include <node.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+using namespace v8;
+
+namespace node_gdal {
+
+// The field names of a feature definition as internalized V8 strings
+// and a name -> index map, created once per schema instead of once
+// per feature
+//
+// Objects that get their properties in the same order from the same
+// internalized keys share one hidden class in V8
+//
+// An entry is checked against the current field names of the definition
+// on every lookup, so renamed fields and reused OGRFeatureDefn addresses
+// are detected. Main thread only.
+
+class FieldNames {
+    public:
+  static FieldNames *get(OGRFeatureDefn *defn);
+  ~FieldNames();
+
+  inline int count() {
+    return static_cast<int>(names.size());
+  }
+  Local<String> name(int i);
+  // Same result as OGRFeatureDefn::GetFieldIndex (first match, ASCII
+  // case-insensitive), -1 if not found
+  int index(std::string name);
+  // index() of the name of field i, differs from i for duplicate names
+  inline int indexOf(int i) {
+    return first[i];
+  }
+  // Copies name() and indexOf() of all fields, the copies remain valid
+  // when JS code (a getter) evicts this entry from the cache
+  void copy(std::vector<Local<String>> &keys, std::vector<int> &indices);
+
+    private:
+  FieldNames(OGRFeatureDefn *defn);
+  bool matches(OGRFeatureDefn *defn);
+
+  std::vector<std::string> names;
+  std::vector<Nan::Persistent<String, Nan::CopyablePersistentTraits<String>>> keys;
+  std::unordered_map<std::string, int> indices;
+  std::vector<int> first;
+
+  // Never destroyed, the persistent handles must not outlive the isolate
+  static std::map<OGRFeatureDefn *, std::unique_ptr<FieldNames>> *cache;
+};
+
+} // namespace node_gdal
+
+#endif
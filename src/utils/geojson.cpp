@@ -0,0 +1,605 @@
+#include "geojson.hpp"
+
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <string>
+
+namespace node_gdal {
+
+namespace GeoJSON {
+
+static Local<Array> position(double x, double y, double z, bool is3d) {
+  Local<Array> pos = Nan::New<Array>(is3d ? 3 : 2);
+  Nan::Set(pos, 0, Nan::New<Number>(x));
+  Nan::Set(pos, 1, Nan::New<Number>(y));
+  if (is3d) Nan::Set(pos, 2, Nan::New<Number>(z));
+  return pos;
+}
+
+static Local<Array> curveCoordinates(OGRLineString *line, bool is3d) {
+  Nan::EscapableHandleScope scope;
+  int n = line->getNumPoints();
+  Local<Array> coords = Nan::New<Array>(n);
+  for (int i = 0; i < n; i++) Nan::Set(coords, i, position(line->getX(i), line->getY(i), line->getZ(i), is3d));
+  return scope.Escape(coords);
+}
+
+static Local<Array> polygonCoordinates(OGRPolygon *polygon, bool is3d) {
+  Nan::EscapableHandleScope scope;
+  OGRLinearRing *exterior = polygon->getExteriorRing();
+  if (exterior == nullptr || exterior->IsEmpty()) return scope.Escape(Nan::New<Array>(0));
+  int n = polygon->getNumInteriorRings();
+  Local<Array> rings = Nan::New<Array>(n + 1);
+  Nan::Set(rings, 0, curveCoordinates(exterior, is3d));
+  for (int i = 0; i < n; i++) Nan::Set(rings, i + 1, curveCoordinates(polygon->getInteriorRing(i), is3d));
+  return scope.Escape(rings);
+}
+
+static Local<Value> coordinates(OGRGeometry *geom, OGRwkbGeometryType type, bool is3d) {
+  Nan::EscapableHandleScope scope;
+  switch (type) {
+    case wkbPoint: {
+      OGRPoint *point = static_cast<OGRPoint *>(geom);
+      if (point->IsEmpty()) return scope.Escape(Nan::New<Array>(0));
+      return scope.Escape(position(point->getX(), point->getY(), point->getZ(), is3d));
+    }
+    case wkbLineString: return scope.Escape(curveCoordinates(static_cast<OGRLineString *>(geom), is3d));
+    case wkbPolygon: return scope.Escape(polygonCoordinates(static_cast<OGRPolygon *>(geom), is3d));
+    case wkbMultiPoint:
+    case wkbMultiLineString:
+    case wkbMultiPolygon: {
+      OGRGeometryCollection *collection = static_cast<OGRGeometryCollection *>(geom);
+      OGRwkbGeometryType child_type = type == wkbMultiPoint ? wkbPoint
+        : type == wkbMultiLineString                        ? wkbLineString
+                                                            : wkbPolygon;
+      int n = collection->getNumGeometries();
+      Local<Array> coords = Nan::New<Array>(n);
+      for (int i = 0; i < n; i++) {
+        Nan::Set(coords, i, coordinates(collection->getGeometryRef(i), child_type, is3d));
+      }
+      return scope.Escape(coords);
+    }
+    default: return scope.Escape(Nan::Undefined());
+  }
+}
+
+Local<Value> FromGeometry(OGRGeometry *geom) {
+  Nan::EscapableHandleScope scope;
+
+  OGRwkbGeometryType type = wkbFlatten(geom->getGeometryType());
+  bool is3d = geom->getCoordinateDimension() == 3;
+
+#if GDAL_VERSION_MAJOR >= 2
+  // Curves have no GeoJSON representation
+  if (OGR_GT_IsNonLinear(type)) {
+    OGRGeometry *linear = geom->getLinearGeometry();
+    if (linear == nullptr) {
+      Nan::ThrowError("Failed to linearize the geometry");
+      return Local<Value>();
+    }
+    Local<Value> result = FromGeometry(linear);
+    delete linear;
+    if (result.IsEmpty()) return Local<Value>();
+    return scope.Escape(result);
+  }
+#endif
+
+  Local<Object> obj = Nan::New<Object>();
+  switch (type) {
+    case wkbPoint: Nan::Set(obj, Nan::New("type").ToLocalChecked(), Nan::New("Point").ToLocalChecked()); break;
+    case wkbLineString:
+    case wkbLinearRing:
+      Nan::Set(obj, Nan::New("type").ToLocalChecked(), Nan::New("LineString").ToLocalChecked());
+      type = wkbLineString;
+      break;
+    case wkbPolygon: Nan::Set(obj, Nan::New("type").ToLocalChecked(), Nan::New("Polygon").ToLocalChecked()); break;
+    case wkbMultiPoint:
+      Nan::Set(obj, Nan::New("type").ToLocalChecked(), Nan::New("MultiPoint").ToLocalChecked());
+      break;
+    case wkbMultiLineString:
+      Nan::Set(obj, Nan::New("type").ToLocalChecked(), Nan::New("MultiLineString").ToLocalChecked());
+      break;
+    case wkbMultiPolygon:
+      Nan::Set(obj, Nan::New("type").ToLocalChecked(), Nan::New("MultiPolygon").ToLocalChecked());
+      break;
+    case wkbGeometryCollection: {
+      Nan::Set(obj, Nan::New("type").ToLocalChecked(), Nan::New("GeometryCollection").ToLocalChecked());
+      OGRGeometryCollection *collection = static_cast<OGRGeometryCollection *>(geom);
+      int n = collection->getNumGeometries();
+      Local<Array> geometries = Nan::New<Array>(n);
+      for (int i = 0; i < n; i++) {
+        Local<Value> child = FromGeometry(collection->getGeometryRef(i));
+        if (child.IsEmpty()) return Local<Value>();
+        Nan::Set(geometries, i, child);
+      }
+      Nan::Set(obj, Nan::New("geometries").ToLocalChecked(), geometries);
+      return scope.Escape(obj);
+    }
+    default:
+      Nan::ThrowError((std::string("Unsupported geometry type: ") + geom->getGeometryName()).c_str());
+      return Local<Value>();
+  }
+
+  Nan::Set(obj, Nan::New("coordinates").ToLocalChecked(), coordinates(geom, type, is3d));
+  return scope.Escape(obj);
+}
+
+static OGRGeometry *invalid(const char *msg) {
+  Nan::ThrowError((std::string("Invalid GeoJSON: ") + msg).c_str());
+  return nullptr;
+}
+
+static bool getArray(Local<Object> obj, const char *key, Local<Array> &array) {
+  Local<Value> val = Nan::Get(obj, Nan::New(key).ToLocalChecked()).ToLocalChecked();
+  if (!val->IsArray()) return false;
+  array = val.As<Array>();
+  return true;
+}
+
+// A position is [x, y] or [x, y, z], a Float64Array is read in place
+static bool readPosition(Local<Value> val, double &x, double &y, double &z, bool &is3d) {
+  if (val->IsFloat64Array()) {
+    Nan::TypedArrayContents<double> pos(val);
+    if (pos.length() < 2) return false;
+    x = (*pos)[0];
+    y = (*pos)[1];
+    is3d = pos.length() > 2;
+    z = is3d ? (*pos)[2] : 0;
+    return true;
+  }
+  if (!val->IsArray()) return false;
+  Local<Array> pos = val.As<Array>();
+  uint32_t n = pos->Length();
+  if (n < 2) return false;
+  Local<Value> vals[3];
+  for (uint32_t i = 0; i < n && i < 3; i++) {
+    vals[i] = Nan::Get(pos, i).ToLocalChecked();
+    if (!vals[i]->IsNumber()) return false;
+  }
+  x = Nan::To<double>(vals[0]).ToChecked();
+  y = Nan::To<double>(vals[1]).ToChecked();
+  is3d = n > 2;
+  z = is3d ? Nan::To<double>(vals[2]).ToChecked() : 0;
+  return true;
+}
+
+// An array of positions, or a Float64Array of interleaved x, y
+static bool readPoints(Local<Value> val, OGRLineString *line) {
+  if (val->IsFloat64Array()) {
+    Nan::TypedArrayContents<double> xy(val);
+    if (xy.length() % 2) return false;
+    int n = static_cast<int>(xy.length() / 2);
+    line->setNumPoints(n, FALSE);
+    for (int i = 0; i < n; i++) line->setPoint(i, (*xy)[2 * i], (*xy)[2 * i + 1]);
+    return true;
+  }
+  if (!val->IsArray()) return false;
+  Local<Array> points = val.As<Array>();
+  int n = static_cast<int>(points->Length());
+  line->setNumPoints(n, FALSE);
+  for (int i = 0; i < n; i++) {
+    double x, y, z;
+    bool is3d;
+    if (!readPosition(Nan::Get(points, i).ToLocalChecked(), x, y, z, is3d)) return false;
+    if (is3d)
+      line->setPoint(i, x, y, z);
+    else
+      line->setPoint(i, x, y);
+  }
+  return true;
+}
+
+static bool readRings(Local<Value> val, OGRPolygon *polygon) {
+  if (!val->IsArray()) return false;
+  Local<Array> rings = val.As<Array>();
+  for (uint32_t i = 0; i < rings->Length(); i++) {
+    OGRLinearRing *ring = new OGRLinearRing();
+    if (!readPoints(Nan::Get(rings, i).ToLocalChecked(), ring)) {
+      delete ring;
+      return false;
+    }
+    polygon->addRingDirectly(ring);
+  }
+  return true;
+}
+
+// Reads the coordinates of a non-collection geometry
+static OGRGeometry *fromCoordinates(OGRwkbGeometryType type, Local<Value> coords) {
+  switch (type) {
+    case wkbPoint: {
+      std::unique_ptr<OGRPoint> point(new OGRPoint());
+      if (coords->IsArray() && coords.As<Array>()->Length() == 0) return point.release();
+      double x, y, z;
+      bool is3d;
+      if (!readPosition(coords, x, y, z, is3d)) return invalid("bad Point coordinates");
+      point->setX(x);
+      point->setY(y);
+      if (is3d) point->setZ(z);
+      return point.release();
+    }
+    case wkbLineString: {
+      std::unique_ptr<OGRLineString> line(new OGRLineString());
+      if (!readPoints(coords, line.get())) return invalid("bad LineString coordinates");
+      return line.release();
+    }
+    case wkbPolygon: {
+      std::unique_ptr<OGRPolygon> polygon(new OGRPolygon());
+      if (!readRings(coords, polygon.get())) return invalid("bad Polygon coordinates");
+      return polygon.release();
+    }
+    case wkbMultiPoint:
+    case wkbMultiLineString:
+    case wkbMultiPolygon: {
+      if (!coords->IsArray()) return invalid("coordinates must be an array");
+      std::unique_ptr<OGRGeometryCollection> collection(
+        type == wkbMultiPoint            ? static_cast<OGRGeometryCollection *>(new OGRMultiPoint())
+          : type == wkbMultiLineString ? static_cast<OGRGeometryCollection *>(new OGRMultiLineString())
+                                       : static_cast<OGRGeometryCollection *>(new OGRMultiPolygon()));
+      OGRwkbGeometryType child_type = type == wkbMultiPoint ? wkbPoint
+        : type == wkbMultiLineString                        ? wkbLineString
+                                                            : wkbPolygon;
+      Local<Array> children = coords.As<Array>();
+      for (uint32_t i = 0; i < children->Length(); i++) {
+        OGRGeometry *child = fromCoordinates(child_type, Nan::Get(children, i).ToLocalChecked());
+        if (child == nullptr) return nullptr;
+        collection->addGeometryDirectly(child);
+      }
+      return collection.release();
+    }
+    default: return invalid("unsupported geometry type");
+  }
+}
+
+OGRGeometry *ToGeometry(Local<Value> geojson) {
+  Nan::HandleScope scope;
+
+  if (!geojson->IsObject()) return invalid("geometry must be an object");
+  Local<Object> obj = geojson.As<Object>();
+
+  Local<Value> type_val = Nan::Get(obj, Nan::New("type").ToLocalChecked()).ToLocalChecked();
+  if (!type_val->IsString()) return invalid("missing type");
+  std::string type = *Nan::Utf8String(type_val);
+
+  if (type == "GeometryCollection") {
+    Local<Array> geometries;
+    if (!getArray(obj, "geometries", geometries)) return invalid("geometries must be an array");
+    std::unique_ptr<OGRGeometryCollection> collection(new OGRGeometryCollection());
+    for (uint32_t i = 0; i < geometries->Length(); i++) {
+      OGRGeometry *child = ToGeometry(Nan::Get(geometries, i).ToLocalChecked());
+      if (child == nullptr) return nullptr;
+      collection->addGeometryDirectly(child);
+    }
+    return collection.release();
+  }
+
+  OGRwkbGeometryType wkb_type;
+  if (type == "Point")
+    wkb_type = wkbPoint;
+  else if (type == "LineString")
+    wkb_type = wkbLineString;
+  else if (type == "Polygon")
+    wkb_type = wkbPolygon;
+  else if (type == "MultiPoint")
+    wkb_type = wkbMultiPoint;
+  else if (type == "MultiLineString")
+    wkb_type = wkbMultiLineString;
+  else if (type == "MultiPolygon")
+    wkb_type = wkbMultiPolygon;
+  else
+    return invalid((std::string("unsupported geometry type ") + type).c_str());
+
+  Local<Value> coords = Nan::Get(obj, Nan::New("coordinates").ToLocalChecked()).ToLocalChecked();
+  return fromCoordinates(wkb_type, coords);
+}
+
+Writer::Writer(int precision, bool bbox)
+  : out(), precision(precision), bbox(bbox), count(0), extent(), has_extent(false) {
+}
+
+std::string &Writer::str() {
+  return out;
+}
+
+// The shortest of %.15g, %.16g and %.17g that parses back to the same value
+static void roundTrip(char *buf, size_t size, double value) {
+  for (int digits = 15; digits < 17; digits++) {
+    snprintf(buf, size, "%.*g", digits, value);
+    if (strtod(buf, nullptr) == value) return;
+  }
+  snprintf(buf, size, "%.17g", value);
+}
+
+// JSON has no NaN or Infinity
+// A negative number of decimals writes the value without any loss
+void Writer::number(double value, int decimals) {
+  if (!std::isfinite(value)) {
+    out += "null";
+    return;
+  }
+  char buf[64];
+  if (decimals < 0) {
+    roundTrip(buf, sizeof(buf), value);
+    out += buf;
+    return;
+  }
+  int len = snprintf(buf, sizeof(buf), "%.*f", decimals, value);
+  if (len < 0 || len >= static_cast<int>(sizeof(buf))) {
+    roundTrip(buf, sizeof(buf), value);
+    out += buf;
+    return;
+  }
+  // trim the trailing zeros of the decimals
+  if (strchr(buf, '.') != nullptr) {
+    while (len > 0 && buf[len - 1] == '0') len--;
+    if (len > 0 && buf[len - 1] == '.') len--;
+  }
+  buf[len] = 0;
+  out += strcmp(buf, "-0") == 0 ? "0" : buf;
+}
+
+void Writer::coordinate(double value) {
+  number(value, precision);
+}
+
+void Writer::string(const char *str) {
+  out += '"';
+  for (const char *c = str; *c; c++) {
+    switch (*c) {
+      case '"': out += "\\\""; break;
+      case '\\': out += "\\\\"; break;
+      case '\n': out += "\\n"; break;
+      case '\r': out += "\\r"; break;
+      case '\t': out += "\\t"; break;
+      case '\b': out += "\\b"; break;
+      case '\f': out += "\\f"; break;
+      default:
+        if (static_cast<unsigned char>(*c) < 0x20) {
+          char buf[8];
+          snprintf(buf, sizeof(buf), "\\u%04x", static_cast<unsigned char>(*c));
+          out += buf;
+        } else {
+          out += *c;
+        }
+    }
+  }
+  out += '"';
+}
+
+void Writer::position(double x, double y, double z, bool is3d) {
+  out += '[';
+  coordinate(x);
+  out += ',';
+  coordinate(y);
+  if (is3d) {
+    out += ',';
+    coordinate(z);
+  }
+  out += ']';
+}
+
+void Writer::points(OGRLineString *line, bool is3d) {
+  out += '[';
+  for (int i = 0; i < line->getNumPoints(); i++) {
+    if (i > 0) out += ',';
+    position(line->getX(i), line->getY(i), line->getZ(i), is3d);
+  }
+  out += ']';
+}
+
+void Writer::rings(OGRPolygon *polygon, bool is3d) {
+  out += '[';
+  OGRLinearRing *exterior = polygon->getExteriorRing();
+  if (exterior != nullptr && !exterior->IsEmpty()) {
+    points(exterior, is3d);
+    for (int i = 0; i < polygon->getNumInteriorRings(); i++) {
+      out += ',';
+      points(polygon->getInteriorRing(i), is3d);
+    }
+  }
+  out += ']';
+}
+
+// Same layout as the coordinates of FromGeometry
+void Writer::coordinates(OGRGeometry *geom, OGRwkbGeometryType type, bool is3d) {
+  switch (type) {
+    case wkbPoint: {
+      OGRPoint *point = static_cast<OGRPoint *>(geom);
+      if (point->IsEmpty())
+        out += "[]";
+      else
+        position(point->getX(), point->getY(), point->getZ(), is3d);
+      return;
+    }
+    case wkbLineString: points(static_cast<OGRLineString *>(geom), is3d); return;
+    case wkbPolygon: rings(static_cast<OGRPolygon *>(geom), is3d); return;
+    default: {
+      OGRGeometryCollection *collection = static_cast<OGRGeometryCollection *>(geom);
+      OGRwkbGeometryType child_type = type == wkbMultiPoint ? wkbPoint
+        : type == wkbMultiLineString                        ? wkbLineString
+                                                            : wkbPolygon;
+      out += '[';
+      for (int i = 0; i < collection->getNumGeometries(); i++) {
+        if (i > 0) out += ',';
+        coordinates(collection->getGeometryRef(i), child_type, is3d);
+      }
+      out += ']';
+      return;
+    }
+  }
+}
+
+void Writer::geometry(OGRGeometry *geom) {
+  OGRwkbGeometryType type = wkbFlatten(geom->getGeometryType());
+  bool is3d = geom->getCoordinateDimension() == 3;
+
+#if GDAL_VERSION_MAJOR >= 2
+  if (OGR_GT_IsNonLinear(type)) {
+    std::unique_ptr<OGRGeometry> linear(geom->getLinearGeometry());
+    if (linear == nullptr) throw "Failed to linearize the geometry";
+    geometry(linear.get());
+    return;
+  }
+#endif
+
+  const char *name;
+  switch (type) {
+    case wkbPoint: name = "Point"; break;
+    case wkbLineString:
+    case wkbLinearRing:
+      name = "LineString";
+      type = wkbLineString;
+      break;
+    case wkbPolygon: name = "Polygon"; break;
+    case wkbMultiPoint: name = "MultiPoint"; break;
+    case wkbMultiLineString: name = "MultiLineString"; break;
+    case wkbMultiPolygon: name = "MultiPolygon"; break;
+    case wkbGeometryCollection: {
+      OGRGeometryCollection *collection = static_cast<OGRGeometryCollection *>(geom);
+      out += "{\"type\":\"GeometryCollection\",\"geometries\":[";
+      for (int i = 0; i < collection->getNumGeometries(); i++) {
+        if (i > 0) out += ',';
+        geometry(collection->getGeometryRef(i));
+      }
+      out += "]}";
+      return;
+    }
+    default: throw "Unsupported geometry type";
+  }
+
+  out += "{\"type\":\"";
+  out += name;
+  out += "\",\"coordinates\":";
+  coordinates(geom, type, is3d);
+  out += '}';
+}
+
+void Writer::envelope(const OGREnvelope &env) {
+  out += "\"bbox\":[";
+  coordinate(env.MinX);
+  out += ',';
+  coordinate(env.MinY);
+  out += ',';
+  coordinate(env.MaxX);
+  out += ',';
+  coordinate(env.MaxY);
+  out += ']';
+}
+
+// Numbers and lists of numbers as JSON numbers, everything else as
+// the string representation of OGR
+void Writer::field(OGRFeature *feature, int i) {
+#if GDAL_VERSION_MAJOR > 2 || (GDAL_VERSION_MAJOR == 2 && GDAL_VERSION_MINOR >= 2)
+  if (!feature->IsFieldSetAndNotNull(i)) {
+#else
+  if (!feature->IsFieldSet(i)) {
+#endif
+    out += "null";
+    return;
+  }
+  int n;
+  switch (feature->GetFieldDefnRef(i)->GetType()) {
+    case OFTInteger: out += std::to_string(feature->GetFieldAsInteger(i)); return;
+#if GDAL_VERSION_MAJOR >= 2
+    case OFTInteger64: out += std::to_string(static_cast<long long>(feature->GetFieldAsInteger64(i))); return;
+    case OFTInteger64List: {
+      const GIntBig *values = feature->GetFieldAsInteger64List(i, &n);
+      out += '[';
+      for (int j = 0; j < n; j++) {
+        if (j > 0) out += ',';
+        out += std::to_string(static_cast<long long>(values[j]));
+      }
+      out += ']';
+      return;
+    }
+#endif
+    case OFTReal: number(feature->GetFieldAsDouble(i), -1); return;
+    case OFTIntegerList: {
+      const int *values = feature->GetFieldAsIntegerList(i, &n);
+      out += '[';
+      for (int j = 0; j < n; j++) {
+        if (j > 0) out += ',';
+        out += std::to_string(values[j]);
+      }
+      out += ']';
+      return;
+    }
+    case OFTRealList: {
+      const double *values = feature->GetFieldAsDoubleList(i, &n);
+      out += '[';
+      for (int j = 0; j < n; j++) {
+        if (j > 0) out += ',';
+        number(values[j], -1);
+      }
+      out += ']';
+      return;
+    }
+    case OFTStringList: {
+      char **values = feature->GetFieldAsStringList(i);
+      out += '[';
+      for (int j = 0; values != nullptr && values[j] != nullptr; j++) {
+        if (j > 0) out += ',';
+        string(values[j]);
+      }
+      out += ']';
+      return;
+    }
+    default: string(feature->GetFieldAsString(i)); return;
+  }
+}
+
+void Writer::beginCollection() {
+  out += "{\"type\":\"FeatureCollection\",\"features\":[";
+}
+
+void Writer::feature(OGRFeature *feature) {
+  if (count++ > 0) out += ',';
+  out += "{\"type\":\"Feature\"";
+  if (feature->GetFID() != OGRNullFID) {
+    out += ",\"id\":";
+    out += std::to_string(static_cast<long long>(feature->GetFID()));
+  }
+
+  OGRGeometry *geom = feature->GetGeometryRef();
+  if (bbox && geom != nullptr && !geom->IsEmpty()) {
+    OGREnvelope env;
+    geom->getEnvelope(&env);
+    out += ',';
+    envelope(env);
+    if (has_extent)
+      extent.Merge(env);
+    else
+      extent = env;
+    has_extent = true;
+  }
+
+  out += ",\"properties\":{";
+  OGRFeatureDefn *defn = feature->GetDefnRef();
+  for (int i = 0; i < defn->GetFieldCount(); i++) {
+    if (i > 0) out += ',';
+    string(defn->GetFieldDefn(i)->GetNameRef());
+    out += ':';
+    field(feature, i);
+  }
+  out += "},\"geometry\":";
+  if (geom != nullptr)
+    geometry(geom);
+  else
+    out += "null";
+  out += '}';
+}
+
+void Writer::endCollection() {
+  out += ']';
+  if (bbox && has_extent) {
+    out += ',';
+    envelope(extent);
+  }
+  out += '}';
+}
+
+} // namespace GeoJSON
+
+} // namespace node_gdal
@@ -0,0 +1,65 @@
+#ifndef __NODE_GDAL_GEOJSON_H__
+#define __NODE_GDAL_GEOJSON_H__
+
+#include <string>
+
+// node
+#include <node.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+using namespace v8;
+
+namespace node_gdal {
+
+// GeoJSON geometries built directly from / to V8 objects, without going
+// through a JSON string, and a GeoJSON text writer
+
+namespace GeoJSON {
+
+// Throws a JS error and returns an empty handle on unsupported geometries
+Local<Value> FromGeometry(OGRGeometry *geom);
+// Throws a JS error and returns nullptr on invalid GeoJSON
+OGRGeometry *ToGeometry(Local<Value> geojson);
+
+// Appends GeoJSON text to a growable buffer, does not access V8 and
+// throws a const char * on unsupported geometries
+//
+// precision is the number of decimals of the coordinates, a negative
+// value writes them without any loss, as are the attribute values
+class Writer {
+    public:
+  Writer(int precision, bool bbox);
+
+  void beginCollection();
+  void feature(OGRFeature *feature);
+  void endCollection();
+  std::string &str();
+
+    private:
+  void number(double value, int decimals);
+  void coordinate(double value);
+  void string(const char *str);
+  void position(double x, double y, double z, bool is3d);
+  void points(OGRLineString *line, bool is3d);
+  void rings(OGRPolygon *polygon, bool is3d);
+  void coordinates(OGRGeometry *geom, OGRwkbGeometryType type, bool is3d);
+  void geometry(OGRGeometry *geom);
+  void envelope(const OGREnvelope &env);
+  void field(OGRFeature *feature, int i);
+
+  std::string out;
+  int precision;
+  bool bbox;
+  size_t count;
+  OGREnvelope extent;
+  bool has_extent;
+};
+} // namespace GeoJSON
+
+} // namespace node_gdal
+#endif
@@ -0,0 +1,223 @@
+#include "layer_columns.hpp"
+#include "field_types.hpp"
+#include "typed_array.hpp"
+
+#include <cstring>
+#include <limits>
+
+namespace node_gdal {
+
+LayerColumns::LayerColumns()
+  : columns(), geometry(GEOMETRY_WKB), count(0), fids(), geom_offsets(), wkb(), xy(), geom_valid() {
+}
+
+int LayerColumns::parse(const Nan::FunctionCallbackInfo<Value> &info, int num, OGRFeatureDefn *defn) {
+  std::vector<int> indices;
+
+  if (info.Length() > num && !info[num]->IsUndefined() && !info[num]->IsNull()) {
+    if (!info[num]->IsArray()) {
+      Nan::ThrowTypeError("fields must be an array of field names");
+      return 1;
+    }
+    Local<Array> names = info[num].As<Array>();
+    for (uint32_t i = 0; i < names->Length(); i++) {
+      Local<Value> name = Nan::Get(names, i).ToLocalChecked();
+      if (!name->IsString()) {
+        Nan::ThrowTypeError("fields must be an array of field names");
+        return 1;
+      }
+      int index = defn->GetFieldIndex(*Nan::Utf8String(name));
+      if (index < 0) {
+        Nan::ThrowError((std::string("Specified field name does not exist: ") + *Nan::Utf8String(name)).c_str());
+        return 1;
+      }
+      indices.push_back(index);
+    }
+  } else {
+    for (int i = 0; i < defn->GetFieldCount(); i++) indices.push_back(i);
+  }
+
+  for (int index : indices) {
+    OGRFieldDefn *field = defn->GetFieldDefn(index);
+    Column col;
+    col.name = field->GetNameRef();
+    col.index = index;
+    col.type = field->GetType();
+    switch (col.type) {
+      case OFTInteger: col.storage = STORAGE_INT32; break;
+      case OFTReal:
+#if GDAL_VERSION_MAJOR >= 2
+      case OFTInteger64:
+#endif
+        col.storage = STORAGE_FLOAT64;
+        break;
+      default: col.storage = STORAGE_STRING; break;
+    }
+    if (col.storage == STORAGE_STRING) col.offsets.push_back(0);
+    columns.push_back(col);
+  }
+
+  if (info.Length() > num + 1 && !info[num + 1]->IsUndefined() && !info[num + 1]->IsNull()) {
+    if (!info[num + 1]->IsString()) {
+      Nan::ThrowTypeError("geometry must be a string");
+      return 1;
+    }
+    std::string mode = *Nan::Utf8String(info[num + 1]);
+    if (mode == "wkb")
+      geometry = GEOMETRY_WKB;
+    else if (mode == "xy")
+      geometry = GEOMETRY_XY;
+    else if (mode == "none")
+      geometry = GEOMETRY_NONE;
+    else {
+      Nan::ThrowError("geometry must be one of 'wkb', 'xy' or 'none'");
+      return 1;
+    }
+  }
+  if (geometry != GEOMETRY_NONE) geom_offsets.push_back(0);
+
+  return 0;
+}
+
+void LayerColumns::setValid(std::vector<uint8_t> &bitmap, size_t i, bool valid) {
+  if (i % 8 == 0) bitmap.push_back(0);
+  if (valid) bitmap.back() |= static_cast<uint8_t>(1 << (i % 8));
+}
+
+int32_t LayerColumns::checkedOffset(size_t offset) {
+  if (offset > static_cast<size_t>(std::numeric_limits<int32_t>::max()))
+    throw "Column data exceeds 2GB, use a smaller batchSize";
+  return static_cast<int32_t>(offset);
+}
+
+// All the vertices of a geometry, the parts are flattened
+void LayerColumns::appendXY(OGRGeometryH geom, std::vector<double> &xy) {
+  int parts = OGR_G_GetGeometryCount(geom);
+  if (parts > 0) {
+    for (int i = 0; i < parts; i++) appendXY(OGR_G_GetGeometryRef(geom, i), xy);
+    return;
+  }
+  int points = OGR_G_GetPointCount(geom);
+  if (points <= 0) return;
+  size_t start = xy.size();
+  xy.resize(start + 2 * points);
+  OGR_G_GetPoints(geom, &xy[start], 2 * sizeof(double), &xy[start + 1], 2 * sizeof(double), nullptr, 0);
+}
+
+void LayerColumns::read(OGRLayer *layer, size_t max, AsyncProgress *progress) {
+  OGRFeature *feature;
+
+  while ((max == 0 || count < max) && (feature = layer->GetNextFeature()) != nullptr) {
+    if (progress != nullptr && progress->aborted()) {
+      OGRFeature::DestroyFeature(feature);
+      throw AsyncAbortedMessage;
+    }
+
+    fids.push_back(static_cast<double>(feature->GetFID()));
+    for (Column &col : columns) {
+#if GDAL_VERSION_MAJOR > 2 || (GDAL_VERSION_MAJOR == 2 && GDAL_VERSION_MINOR >= 2)
+      bool valid = feature->IsFieldSetAndNotNull(col.index);
+#else
+      bool valid = feature->IsFieldSet(col.index);
+#endif
+      setValid(col.valid, count, valid);
+      switch (col.storage) {
+        case STORAGE_INT32: col.ints.push_back(valid ? feature->GetFieldAsInteger(col.index) : 0); break;
+        case STORAGE_FLOAT64:
+#if GDAL_VERSION_MAJOR >= 2
+          if (col.type == OFTInteger64)
+            col.doubles.push_back(valid ? static_cast<double>(feature->GetFieldAsInteger64(col.index)) : 0);
+          else
+#endif
+            col.doubles.push_back(valid ? feature->GetFieldAsDouble(col.index) : 0);
+          break;
+        case STORAGE_STRING:
+          if (valid) {
+            const char *str = feature->GetFieldAsString(col.index);
+            col.data.insert(col.data.end(), str, str + strlen(str));
+          }
+          col.offsets.push_back(checkedOffset(col.data.size()));
+          break;
+      }
+    }
+
+    if (geometry != GEOMETRY_NONE) {
+      OGRGeometry *geom = feature->GetGeometryRef();
+      setValid(geom_valid, count, geom != nullptr);
+      if (geom != nullptr && geometry == GEOMETRY_WKB) {
+        size_t start = wkb.size();
+        wkb.resize(start + geom->WkbSize());
+        geom->exportToWkb(wkbNDR, &wkb[start]);
+        geom_offsets.push_back(checkedOffset(wkb.size()));
+      } else if (geom != nullptr && geometry == GEOMETRY_XY) {
+        appendXY(static_cast<OGRGeometryH>(geom), xy);
+        geom_offsets.push_back(checkedOffset(xy.size() / 2));
+      } else
+        geom_offsets.push_back(geom_offsets.back());
+    }
+
+    OGRFeature::DestroyFeature(feature);
+    count++;
+  }
+}
+
+template <typename T> static Local<Value> toTypedArray(GDALDataType type, const std::vector<T> &values) {
+  Nan::EscapableHandleScope scope;
+  Local<Value> array = TypedArray::New(type, values.size());
+  if (array.IsEmpty() || !array->IsObject()) return scope.Escape(array);
+  if (!values.empty()) {
+    Nan::TypedArrayContents<GByte> contents(array);
+    memcpy(*contents, values.data(), values.size() * sizeof(T));
+  }
+  return scope.Escape(array);
+}
+
+/*
+ * {
+ *   count: Number,
+ *   fid: Float64Array,
+ *   fields: { name: { type, values | offsets + data, valid } },
+ *   geometry: { wkb | xy, offsets, valid }
+ * }
+ */
+Local<Object> LayerColumns::toObject() {
+  Nan::EscapableHandleScope scope;
+  Local<Object> result = Nan::New<Object>();
+
+  Nan::Set(result, Nan::New("count").ToLocalChecked(), Nan::New<Number>(static_cast<double>(count)));
+  Nan::Set(result, Nan::New("fid").ToLocalChecked(), toTypedArray(GDT_Float64, fids));
+
+  Local<Object> fields = Nan::New<Object>();
+  for (Column &col : columns) {
+    Local<Object> column = Nan::New<Object>();
+    Nan::Set(column, Nan::New("type").ToLocalChecked(), Nan::New(getFieldTypeName(col.type)).ToLocalChecked());
+    switch (col.storage) {
+      case STORAGE_INT32: Nan::Set(column, Nan::New("values").ToLocalChecked(), toTypedArray(GDT_Int32, col.ints)); break;
+      case STORAGE_FLOAT64:
+        Nan::Set(column, Nan::New("values").ToLocalChecked(), toTypedArray(GDT_Float64, col.doubles));
+        break;
+      case STORAGE_STRING:
+        Nan::Set(column, Nan::New("offsets").ToLocalChecked(), toTypedArray(GDT_Int32, col.offsets));
+        Nan::Set(column, Nan::New("data").ToLocalChecked(), toTypedArray(GDT_Byte, col.data));
+        break;
+    }
+    Nan::Set(column, Nan::New("valid").ToLocalChecked(), toTypedArray(GDT_Byte, col.valid));
+    Nan::Set(fields, Nan::New(col.name).ToLocalChecked(), column);
+  }
+  Nan::Set(result, Nan::New("fields").ToLocalChecked(), fields);
+
+  if (geometry != GEOMETRY_NONE) {
+    Local<Object> geom = Nan::New<Object>();
+    if (geometry == GEOMETRY_WKB)
+      Nan::Set(geom, Nan::New("wkb").ToLocalChecked(), toTypedArray(GDT_Byte, wkb));
+    else
+      Nan::Set(geom, Nan::New("xy").ToLocalChecked(), toTypedArray(GDT_Float64, xy));
+    Nan::Set(geom, Nan::New("offsets").ToLocalChecked(), toTypedArray(GDT_Int32, geom_offsets));
+    Nan::Set(geom, Nan::New("valid").ToLocalChecked(), toTypedArray(GDT_Byte, geom_valid));
+    Nan::Set(result, Nan::New("geometry").ToLocalChecked(), geom);
+  }
+
+  return scope.Escape(result);
+}
+
+} // namespace node_gdal
@@ -0,0 +1,77 @@
+#ifndef __LAYER_COLUMNS_H__
+#define __LAYER_COLUMNS_H__
+
+#include <string>
+#include <vector>
+
+// node
+#include <node.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// ogr
+#include <ogrsf_frmts.h>
+
+#include "../async/async_progress.hpp"
+
+using namespace v8;
+
+namespace node_gdal {
+
+// The features of a layer read into columns
+//
+// inputs:
+// field names (all by default), geometry mode ("wkb", "xy" or "none")
+//
+// outputs:
+// one typed array per field, string fields as offsets + UTF-8 bytes,
+// validity bitmaps (LSB first) and the geometries as a contiguous buffer
+// with offsets
+//
+// parse() and toObject() run on the main thread, read() does not access V8
+
+class LayerColumns {
+    public:
+  enum GeometryMode { GEOMETRY_NONE, GEOMETRY_WKB, GEOMETRY_XY };
+
+  LayerColumns();
+
+  int parse(const Nan::FunctionCallbackInfo<Value> &info, int num, OGRFeatureDefn *defn);
+  // Reads up to max features from the current position (all if max is 0),
+  // throws a const char * on error
+  void read(OGRLayer *layer, size_t max, AsyncProgress *progress);
+  Local<Object> toObject();
+
+    private:
+  enum Storage { STORAGE_INT32, STORAGE_FLOAT64, STORAGE_STRING };
+
+  struct Column {
+    std::string name;
+    int index;
+    OGRFieldType type;
+    Storage storage;
+    std::vector<int32_t> ints;
+    std::vector<double> doubles;
+    std::vector<int32_t> offsets;
+    std::vector<char> data;
+    std::vector<uint8_t> valid;
+  };
+
+  static void setValid(std::vector<uint8_t> &bitmap, size_t i, bool valid);
+  static void appendXY(OGRGeometryH geom, std::vector<double> &xy);
+  static int32_t checkedOffset(size_t offset);
+
+  std::vector<Column> columns;
+  GeometryMode geometry;
+  size_t count;
+  std::vector<double> fids;
+  std::vector<int32_t> geom_offsets;
+  std::vector<GByte> wkb;
+  std::vector<double> xy;
+  std::vector<uint8_t> geom_valid;
+};
+
+} // namespace node_gdal
+
+#endif
@@ -0,0 +1,151 @@
+
+#include "pinned_block.hpp"
+#include "typed_array.hpp"
+
+#include <node_buffer.h>
+
+namespace node_gdal {
+
+std::list<PinnedBlock *> PinnedBlock::pinned;
+
+PinnedBlock::PinnedBlock(GDALDataset *ds, const std::shared_ptr<Lock> &lock) : ds(ds), lock(lock), buffer() {
+}
+
+PinnedBlock::~PinnedBlock() {
+  buffer.Reset();
+}
+
+// The last reference on the backing store is gone
+void PinnedBlock::deleter(void *, size_t, void *data) {
+  std::shared_ptr<Lock> *lock = static_cast<std::shared_ptr<Lock> *>(data);
+  (*lock)->drop();
+  delete lock;
+}
+
+void PinnedBlock::weakCallback(const Nan::WeakCallbackInfo<PinnedBlock> &info) {
+  PinnedBlock *pin = info.GetParameter();
+  // the backing store deleter can run later, after dropAll has stopped seeing this pin
+  pin->lock->drop();
+  pinned.remove(pin);
+  delete pin;
+}
+
+void PinnedBlock::detach() {
+  if (!buffer.IsEmpty()) {
+    Local<ArrayBuffer> ab = Nan::New(buffer);
+    if (ab->IsDetachable()) ab->Detach();
+  }
+  lock->drop();
+}
+
+#if NODE_MAJOR_VERSION >= 14
+Local<ArrayBuffer>
+PinnedBlock::newBuffer(Local<Object> band_obj, void *data, size_t size, const std::shared_ptr<Lock> &lock) {
+  std::shared_ptr<BackingStore> store =
+    ArrayBuffer::NewBackingStore(data, size, deleter, new std::shared_ptr<Lock>(lock));
+  Local<ArrayBuffer> ab = ArrayBuffer::New(v8::Isolate::GetCurrent(), store);
+  Nan::SetPrivate(ab, Nan::New("band_").ToLocalChecked(), band_obj);
+  return ab;
+}
+#endif
+
+Local<Object> PinnedBlock::New(Local<Object> band_obj, GDALDataset *ds, GDALRasterBlock *block) {
+  Nan::EscapableHandleScope scope;
+
+#if NODE_MAJOR_VERSION >= 14
+  std::shared_ptr<Lock> lock = std::make_shared<Lock>(block);
+  size_t size = static_cast<size_t>(block->GetBlockSize());
+  Local<ArrayBuffer> ab = newBuffer(band_obj, block->GetDataRef(), size, lock);
+
+  Local<Value> array = TypedArray::New(block->GetDataType(), ab);
+  if (array.IsEmpty() || !array->IsObject()) {
+    // TypedArray::New threw an error, the lock is dropped with the backing store
+    lock->drop();
+    return scope.Escape(Local<Object>());
+  }
+
+  PinnedBlock *pin = new PinnedBlock(ds, lock);
+  pin->buffer.Reset(ab);
+  pin->buffer.SetWeak(pin, weakCallback, Nan::WeakCallbackType::kParameter);
+  pinned.push_back(pin);
+
+  return scope.Escape(array.As<Object>());
+#else
+  block->DropLock();
+  Nan::ThrowError("Pinned blocks require Node.js 14 or later");
+  return scope.Escape(Local<Object>());
+#endif
+}
+
+Local<Object> PinnedBlock::New(Local<Object> band_obj, GDALDataset *ds, CPLVirtualMem *vmem) {
+  Nan::EscapableHandleScope scope;
+
+#if NODE_MAJOR_VERSION >= 14
+  // V8 aborts on an ArrayBuffer larger than its limit
+  if (CPLVirtualMemGetSize(vmem) > node::Buffer::kMaxLength) {
+    CPLVirtualMemFree(vmem);
+    Nan::ThrowRangeError("Band is too large to be mapped in an ArrayBuffer");
+    return scope.Escape(Local<Object>());
+  }
+
+  std::shared_ptr<Lock> lock = std::make_shared<Lock>(vmem);
+  Local<ArrayBuffer> ab = newBuffer(band_obj, CPLVirtualMemGetAddr(vmem), CPLVirtualMemGetSize(vmem), lock);
+
+  PinnedBlock *pin = new PinnedBlock(ds, lock);
+  pin->buffer.Reset(ab);
+  pin->buffer.SetWeak(pin, weakCallback, Nan::WeakCallbackType::kParameter);
+  pinned.push_back(pin);
+
+  return scope.Escape(ab.As<Object>());
+#else
+  CPLVirtualMemFree(vmem);
+  Nan::ThrowError("Virtual memory mappings require Node.js 14 or later");
+  return scope.Escape(Local<Object>());
+#endif
+}
+
+bool PinnedBlock::release(Local<Object> array) {
+  Nan::HandleScope scope;
+
+  Local<ArrayBuffer> ab;
+  if (array->IsArrayBuffer())
+    ab = array.As<ArrayBuffer>();
+  else if (array->IsArrayBufferView())
+    ab = array.As<ArrayBufferView>()->Buffer();
+  else
+    return false;
+
+  for (auto it = pinned.begin(); it != pinned.end(); it++) {
+    PinnedBlock *pin = *it;
+    if (!pin->buffer.IsEmpty() && Nan::New(pin->buffer) == ab) {
+      pin->detach();
+      pinned.erase(it);
+      delete pin;
+      return true;
+    }
+  }
+  return false;
+}
+
+void PinnedBlock::releaseAll(GDALDataset *ds, bool blocks_only) {
+  Nan::HandleScope scope;
+
+  for (auto it = pinned.begin(); it != pinned.end();) {
+    PinnedBlock *pin = *it;
+    if (pin->ds == ds && (!blocks_only || pin->lock->block != nullptr)) {
+      pin->detach();
+      it = pinned.erase(it);
+      delete pin;
+    } else {
+      it++;
+    }
+  }
+}
+
+void PinnedBlock::dropAll(GDALDataset *ds) {
+  // the ArrayBuffers are not touched, their weak callbacks will clean up the list
+  for (PinnedBlock *pin : pinned)
+    if (pin->ds == ds) pin->lock->drop();
+}
+
+} // namespace node_gdal
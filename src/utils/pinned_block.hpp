@@ -0,0 +1,89 @@
+#ifndef __PINNED_BLOCK_H__
+#define __PINNED_BLOCK_H__
+
+#include <atomic>
+#include <list>
+#include <memory>
+
+// node
+#include <node.h>
+#include <node_version.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// gdal
+#include <cpl_virtualmem.h>
+#include <gdal_priv.h>
+
+using namespace v8;
+
+namespace node_gdal {
+
+/**
+ * A block locked in the GDAL block cache, or a virtual memory mapping of
+ * a band, exposed to JS as the external backing store of an ArrayBuffer,
+ * without any copy
+ *
+ * The block lock is dropped (the mapping is freed):
+ * - when the ArrayBuffer is garbage collected, by the backing store
+ *   deleter which can run on any V8 thread
+ * - when the array is explicitly released, the ArrayBuffer is detached
+ * - before its dataset is flushed or closed, GDAL cannot evict a locked
+ *   block, the ArrayBuffer is detached if it is still alive
+ * - for a mapping, only before its dataset is closed, the mapping reads
+ *   the band through its own page cache
+ *
+ * The ArrayBuffer keeps a reference on the band, so the dataset cannot be
+ * garbage collected while one of its blocks is pinned
+ */
+class PinnedBlock {
+    public:
+  // Returns an empty handle and throws on error
+  static Local<Object> New(Local<Object> band_obj, GDALDataset *ds, GDALRasterBlock *block);
+  // Returns an ArrayBuffer or an empty handle and throws on error
+  static Local<Object> New(Local<Object> band_obj, GDALDataset *ds, CPLVirtualMem *vmem);
+  // Returns false if the array is not a pinned block
+  static bool release(Local<Object> array);
+  // Releases and detaches all blocks of a dataset, and all mappings
+  // unless blocks_only is set, must be called from JS
+  static void releaseAll(GDALDataset *ds, bool blocks_only = false);
+  // Only drops the locks, can be called from the garbage collector
+  static void dropAll(GDALDataset *ds);
+
+    private:
+  // shared with the backing store deleter
+  struct Lock {
+    GDALRasterBlock *block;
+    CPLVirtualMem *vmem;
+    std::atomic<bool> dropped;
+    explicit Lock(GDALRasterBlock *block) : block(block), vmem(nullptr), dropped(false) {
+    }
+    explicit Lock(CPLVirtualMem *vmem) : block(nullptr), vmem(vmem), dropped(false) {
+    }
+    void drop() {
+      if (dropped.exchange(true)) return;
+      if (block != nullptr)
+        block->DropLock();
+      else
+        CPLVirtualMemFree(vmem);
+    }
+  };
+
+  PinnedBlock(GDALDataset *ds, const std::shared_ptr<Lock> &lock);
+  ~PinnedBlock();
+
+  static void weakCallback(const Nan::WeakCallbackInfo<PinnedBlock> &);
+  static void deleter(void *data, size_t length, void *lock);
+  static Local<ArrayBuffer> newBuffer(Local<Object> band_obj, void *data, size_t size, const std::shared_ptr<Lock> &lock);
+  void detach();
+
+  GDALDataset *ds;
+  std::shared_ptr<Lock> lock;
+  Nan::Persistent<ArrayBuffer> buffer;
+
+  static std::list<PinnedBlock *> pinned;
+};
+
+} // namespace node_gdal
+#endif
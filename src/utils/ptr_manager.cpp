@@ -2,6 +2,8 @@
 #include "../gdal_dataset.hpp"
 #include "../gdal_layer.hpp"
 #include "../gdal_rasterband.hpp"
+#include "../gdal_vsijs.hpp"
+#include "pinned_block.hpp"
 
 #include <sstream>
 
@@ -43,11 +45,24 @@ long PtrManager::add(GDALRasterBand *ptr, long parent_uid) {
   return item->uid;
 }
 
-long PtrManager::add(GDALDataset *ptr, uv_mutex_t *async_lock) {
+/*
+ * The result set is written by the async job, with the dataset lock held,
+ * and cleared once it has been registered as a layer. If the dataset
+ * is closed in between, it is released along with the dataset
+ */
+void PtrManager::addPendingResultSet(const std::shared_ptr<OGRLayer *> &result_set, long parent_uid) {
+  std::list<std::weak_ptr<OGRLayer *>> &pending = datasets[parent_uid]->pending_result_sets;
+  // the entries of the completed jobs
+  pending.remove_if([](const std::weak_ptr<OGRLayer *> &ref) { return ref.expired(); });
+  pending.push_back(result_set);
+}
+
+long PtrManager::add(GDALDataset *ptr, AsyncLockRef async_lock, DatasetPoolRef pool) {
   PtrManagerDatasetItem *item = new PtrManagerDatasetItem();
   item->uid = uid++;
   item->ptr = ptr;
   item->async_lock = async_lock;
+  item->pool = pool;
   datasets[item->uid] = item;
   return item->uid;
 }
@@ -74,23 +89,47 @@ void PtrManager::dispose(long uid) {
 void PtrManager::dispose(PtrManagerDatasetItem *item) {
   datasets.erase(item->uid);
 
+  // wait for any async operation still running on this dataset, the ones
+  // waiting for a /vsijs/ read would wait for the event loop forever
+  if (item->async_lock) {
+    item->async_lock->closing = true;
+    VSIJS::cancel(item->async_lock.get());
+    item->async_lock->lock();
+  }
+
   while (!item->layers.empty()) { dispose(item->layers.back()); }
   while (!item->bands.empty()) { dispose(item->bands.back()); }
 
+  for (const std::weak_ptr<OGRLayer *> &ref : item->pending_result_sets) {
+    std::shared_ptr<OGRLayer *> result_set = ref.lock();
+    if (result_set == nullptr || *result_set == nullptr) continue;
+#if GDAL_VERSION_MAJOR < 2
+    item->ptr_datasource->ReleaseResultSet(*result_set);
+#else
+    item->ptr->ReleaseResultSet(*result_set);
+#endif
+    *result_set = nullptr;
+  }
+
 #if GDAL_VERSION_MAJOR < 2
   if (item->ptr_datasource) {
     Dataset::datasource_cache.erase(item->ptr_datasource);
     OGRDataSource::DestroyDataSource(item->ptr_datasource);
   }
 #endif
-  if (item->async_lock) {
-    uv_mutex_destroy(item->async_lock);
-    delete item->async_lock;
-  }
+  // the pooled handles are closed once the async reads using them are done
+  if (item->pool) { item->pool->close(); }
   if (item->ptr) {
+    // GDAL cannot free the blocks that are still locked
+    PinnedBlock::dropAll(item->ptr);
     Dataset::dataset_cache.erase(item->ptr);
     GDALClose(item->ptr);
   }
+  // the jobs still queued hold a reference on the lock and will find it closed
+  if (item->async_lock) {
+    item->async_lock->closed = true;
+    item->async_lock->unlock();
+  }
 
   delete item;
 }
@@ -14,8 +14,12 @@
 // ogr
 #include <ogrsf_frmts.h>
 
+#include "../async/async_lock.hpp"
+#include "dataset_pool.hpp"
+
 #include <list>
 #include <map>
+#include <memory>
 
 using namespace v8;
 
@@ -38,7 +42,10 @@ struct PtrManagerDatasetItem {
   std::list<PtrManagerLayerItem *> layers;
   std::list<PtrManagerRasterBandItem *> bands;
   GDALDataset *ptr;
-  uv_mutex_t *async_lock;
+  node_gdal::AsyncLockRef async_lock;
+  node_gdal::DatasetPoolRef pool;
+  // result sets produced by async jobs that have not yet reached JS
+  std::list<std::weak_ptr<OGRLayer *>> pending_result_sets;
 #if GDAL_VERSION_MAJOR < 2
   OGRDataSource *ptr_datasource;
 #endif
@@ -50,12 +57,13 @@ namespace node_gdal {
 
 class PtrManager {
     public:
-  long add(GDALDataset *ptr, uv_mutex_t *async_lock);
+  long add(GDALDataset *ptr, AsyncLockRef async_lock, DatasetPoolRef pool = nullptr);
 #if GDAL_VERSION_MAJOR < 2
   long add(OGRDataSource *ptr);
 #endif
   long add(GDALRasterBand *ptr, long parent_uid);
   long add(OGRLayer *ptr, long parent_uid, bool is_result_set);
+  void addPendingResultSet(const std::shared_ptr<OGRLayer *> &result_set, long parent_uid);
   void dispose(long uid);
   bool isAlive(long uid);
 
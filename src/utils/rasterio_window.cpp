@@ -0,0 +1,107 @@
+
+#include "rasterio_window.hpp"
+
+#include <cmath>
+#include <limits>
+#include <string>
+
+namespace node_gdal {
+
+RasterIOWindow::RasterIOWindow()
+  : x(0), y(0), w(0), h(0), dfXOff(0), dfYOff(0), dfXSize(0), dfYSize(0), fractional(false), resampling(0) {
+}
+
+// GDALRasterIOGetResampleAlg() is not exported, it also accepts unknown names
+static int parseResampling(const std::string &name) {
+#if GDAL_VERSION_MAJOR >= 2
+  if (EQUAL(name.c_str(), "nearest")) return GRIORA_NearestNeighbour;
+  if (EQUAL(name.c_str(), "bilinear")) return GRIORA_Bilinear;
+  if (EQUAL(name.c_str(), "cubic")) return GRIORA_Cubic;
+  if (EQUAL(name.c_str(), "cubicspline")) return GRIORA_CubicSpline;
+  if (EQUAL(name.c_str(), "lanczos")) return GRIORA_Lanczos;
+  if (EQUAL(name.c_str(), "average")) return GRIORA_Average;
+  if (EQUAL(name.c_str(), "mode")) return GRIORA_Mode;
+#if GDAL_VERSION_MAJOR > 2 || (GDAL_VERSION_MAJOR == 2 && GDAL_VERSION_MINOR >= 1)
+  if (EQUAL(name.c_str(), "gauss")) return GRIORA_Gauss;
+#endif
+#endif
+  return -1;
+}
+
+int RasterIOWindow::parse(const Nan::FunctionCallbackInfo<Value> &info, int num, int resampling_num) {
+  const char *names[] = {"x_offset", "y_offset", "x_size", "y_size"};
+  double values[4];
+
+  for (int i = 0; i < 4; i++) {
+    if (info.Length() < num + i + 1) {
+      Nan::ThrowError((std::string(names[i]) + " must be given").c_str());
+      return 1;
+    }
+    if (!info[num + i]->IsNumber()) {
+      Nan::ThrowTypeError((std::string(names[i]) + " must be a number").c_str());
+      return 1;
+    }
+    values[i] = Nan::To<double>(info[num + i]).ToChecked();
+    if (!std::isfinite(values[i])) {
+      Nan::ThrowRangeError((std::string(names[i]) + " must be a finite number").c_str());
+      return 1;
+    }
+  }
+  dfXOff = values[0];
+  dfYOff = values[1];
+  dfXSize = values[2];
+  dfYSize = values[3];
+
+  // both edges of the window and its size are cast to int below
+  const double min = std::numeric_limits<int>::min(), max = std::numeric_limits<int>::max();
+  const double x0 = std::floor(dfXOff), y0 = std::floor(dfYOff);
+  const double x1 = std::ceil(dfXOff + dfXSize), y1 = std::ceil(dfYOff + dfYSize);
+  for (double v : {x0, y0, x1, y1, x1 - x0, y1 - y0}) {
+    if (v < min || v > max) {
+      Nan::ThrowRangeError("Window is out of the integer range");
+      return 1;
+    }
+  }
+
+  x = static_cast<int>(x0);
+  y = static_cast<int>(y0);
+  w = static_cast<int>(x1 - x0);
+  h = static_cast<int>(y1 - y0);
+  fractional = x != dfXOff || y != dfYOff || w != dfXSize || h != dfYSize;
+
+  if (info.Length() > resampling_num && !info[resampling_num]->IsUndefined() && !info[resampling_num]->IsNull()) {
+    if (!info[resampling_num]->IsString()) {
+      Nan::ThrowTypeError("resampling must be a string");
+      return 1;
+    }
+    std::string name = *Nan::Utf8String(info[resampling_num]);
+    resampling = parseResampling(name);
+    if (resampling < 0) {
+      Nan::ThrowError(("Invalid resampling algorithm: " + name).c_str());
+      return 1;
+    }
+  }
+
+#if GDAL_VERSION_MAJOR < 2
+  if (fractional) {
+    Nan::ThrowError("Fractional windows require GDAL 2.0");
+    return 1;
+  }
+#endif
+  return 0;
+}
+
+#if GDAL_VERSION_MAJOR >= 2
+void RasterIOWindow::apply(GDALRasterIOExtraArg *arg) const {
+  arg->eResampleAlg = static_cast<GDALRIOResampleAlg>(resampling);
+  if (fractional) {
+    arg->bFloatingPointWindowValidity = TRUE;
+    arg->dfXOff = dfXOff;
+    arg->dfYOff = dfYOff;
+    arg->dfXSize = dfXSize;
+    arg->dfYSize = dfYSize;
+  }
+}
+#endif
+
+} // namespace node_gdal
@@ -0,0 +1,46 @@
+#ifndef __RASTERIO_WINDOW_H__
+#define __RASTERIO_WINDOW_H__
+
+// node
+#include <node.h>
+
+// nan
+#include "../nan-wrapper.h"
+
+// gdal
+#include <gdal_priv.h>
+
+using namespace v8;
+
+namespace node_gdal {
+
+// The source window and the resampling of a RasterIO read
+//
+// inputs:
+// x, y, width, height (may be fractional), resampling name
+//
+// outputs:
+// the window rounded out to whole pixels for the integer RasterIO
+// arguments, GDAL reads the exact window through GDALRasterIOExtraArg
+
+class RasterIOWindow {
+    public:
+  int parse(const Nan::FunctionCallbackInfo<Value> &info, int num, int resampling_num);
+
+  RasterIOWindow();
+
+#if GDAL_VERSION_MAJOR >= 2
+  void apply(GDALRasterIOExtraArg *arg) const;
+#endif
+
+  int x, y, w, h;
+
+    private:
+  double dfXOff, dfYOff, dfXSize, dfYSize;
+  bool fractional;
+  int resampling;
+};
+
+} // namespace node_gdal
+
+#endif
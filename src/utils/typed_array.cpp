@@ -1,134 +1,115 @@
 #include "typed_array.hpp"
 
+#include <node_buffer.h>
 #include <sstream>
 
 namespace node_gdal {
 
-// https://github.com/joyent/node/issues/4201#issuecomment-9837340
-
+// Creates the ArrayBuffer and the view directly, without calling the JS
+// constructors, the type is identified from the view itself
 Local<Value> TypedArray::New(GDALDataType type, unsigned int length) {
   Nan::EscapableHandleScope scope;
 
-  Local<Value> val;
-  Local<Function> constructor;
-  Local<Object> global = Nan::GetCurrentContext()->Global();
-
-  const char *name;
-  switch (type) {
-    case GDT_Byte: name = "Uint8Array"; break;
-    case GDT_Int16: name = "Int16Array"; break;
-    case GDT_UInt16: name = "Uint16Array"; break;
-    case GDT_Int32: name = "Int32Array"; break;
-    case GDT_UInt32: name = "Uint32Array"; break;
-    case GDT_Float32: name = "Float32Array"; break;
-    case GDT_Float64: name = "Float64Array"; break;
-    default: Nan::ThrowError("Unsupported array type"); return scope.Escape(Nan::Undefined());
-  }
-
-  // make ArrayBuffer
-  val = Nan::Get(global, Nan::New("ArrayBuffer").ToLocalChecked()).ToLocalChecked();
-
-  if (val.IsEmpty() || !val->IsFunction()) {
-    Nan::ThrowError("Error getting ArrayBuffer constructor");
+  size_t size = length * (size_t)(GDALGetDataTypeSize(type) / 8);
+  if (size > node::Buffer::kMaxLength) {
+    Nan::ThrowRangeError("Array is too large");
     return scope.Escape(Nan::Undefined());
   }
 
-  constructor = val.As<Function>();
-  Local<Value> size = Nan::New<Integer>(length * GDALGetDataTypeSize(type) / 8);
-  Local<Value> array_buffer = Nan::NewInstance(constructor, 1, &size).ToLocalChecked();
-
-  if (array_buffer.IsEmpty() || !array_buffer->IsObject()) {
-    Nan::ThrowError("Error allocating ArrayBuffer");
-    return scope.Escape(Nan::Undefined());
+  switch (type) {
+    case GDT_Byte:
+    case GDT_Int16:
+    case GDT_UInt16:
+    case GDT_Int32:
+    case GDT_UInt32:
+    case GDT_Float32:
+    case GDT_Float64: break;
+    default: Nan::ThrowError("Unsupported array type"); return scope.Escape(Nan::Undefined());
   }
 
-  // make TypedArray
-  val = Nan::Get(global, Nan::New(name).ToLocalChecked()).ToLocalChecked();
-
-  if (val.IsEmpty() || !val->IsFunction()) {
-    Nan::ThrowError("Error getting typed array constructor");
-    return scope.Escape(Nan::Undefined());
-  }
+  return scope.Escape(New(type, ArrayBuffer::New(v8::Isolate::GetCurrent(), size)));
+}
 
-  constructor = val.As<Function>();
-  Local<Object> array = Nan::NewInstance(constructor, 1, &array_buffer).ToLocalChecked();
+// A view over the whole buffer, which can be external memory
+Local<Value> TypedArray::New(GDALDataType type, Local<ArrayBuffer> buffer) {
+  Nan::EscapableHandleScope scope;
 
-  if (array.IsEmpty() || !array->IsObject()) {
-    Nan::ThrowError("Error creating TypedArray");
-    return scope.Escape(Nan::Undefined());
+  size_t length = buffer->ByteLength() / (GDALGetDataTypeSize(type) / 8);
+  Local<Object> array;
+  switch (type) {
+    case GDT_Byte: array = v8::Uint8Array::New(buffer, 0, length); break;
+    case GDT_Int16: array = v8::Int16Array::New(buffer, 0, length); break;
+    case GDT_UInt16: array = v8::Uint16Array::New(buffer, 0, length); break;
+    case GDT_Int32: array = v8::Int32Array::New(buffer, 0, length); break;
+    case GDT_UInt32: array = v8::Uint32Array::New(buffer, 0, length); break;
+    case GDT_Float32: array = v8::Float32Array::New(buffer, 0, length); break;
+    case GDT_Float64: array = v8::Float64Array::New(buffer, 0, length); break;
+    default: Nan::ThrowError("Unsupported array type"); return scope.Escape(Nan::Undefined());
   }
 
-  Nan::Set(array, Nan::New("_gdal_type").ToLocalChecked(), Nan::New(type));
-
   return scope.Escape(array);
 }
 
 GDALDataType TypedArray::Identify(Local<Object> obj) {
-  Nan::HandleScope scope;
-
-  Local<String> sym = Nan::New("_gdal_type").ToLocalChecked();
-  if (!Nan::HasOwnProperty(obj, sym).FromMaybe(false)) return GDT_Unknown;
-  Local<Value> val = Nan::Get(obj, sym).ToLocalChecked();
-  if (!val->IsNumber()) return GDT_Unknown;
+  if (obj->IsUint8Array() || obj->IsInt8Array()) return GDT_Byte;
+  if (obj->IsInt16Array()) return GDT_Int16;
+  if (obj->IsUint16Array()) return GDT_UInt16;
+  if (obj->IsInt32Array()) return GDT_Int32;
+  if (obj->IsUint32Array()) return GDT_UInt32;
+  if (obj->IsFloat32Array()) return GDT_Float32;
+  if (obj->IsFloat64Array()) return GDT_Float64;
+  return GDT_Unknown;
+}
 
-  return (GDALDataType)Nan::To<int32_t>(val).ToChecked();
+bool TypedArray::IsRawMemory(Local<Object> obj) {
+  return obj->IsDataView() || obj->IsArrayBuffer() || obj->IsSharedArrayBuffer();
 }
 
+// Validates the array and returns a pointer to its first element,
+// the byte offset of views (Buffers, subarrays) is taken into account
 void *TypedArray::Validate(Local<Object> obj, GDALDataType type, int min_length) {
   // validate array
   Nan::HandleScope scope;
 
-  GDALDataType src_type = TypedArray::Identify(obj);
-  if (src_type == GDT_Unknown) {
-    Nan::ThrowTypeError("Unable to identify GDAL datatype of passed array object");
-    return NULL;
-  }
-  if (src_type != type) {
-    std::ostringstream ss;
-    ss << "Array type does not match band data type ("
-       << "input: " << GDALGetDataTypeName(src_type) << ", target: " << GDALGetDataTypeName(type) << ")";
+  if (!IsRawMemory(obj)) {
+    GDALDataType src_type = TypedArray::Identify(obj);
+    if (src_type == GDT_Unknown) {
+      Nan::ThrowTypeError("Unable to identify GDAL datatype of passed array object");
+      return NULL;
+    }
+    if (src_type != type) {
+      std::ostringstream ss;
+      ss << "Array type does not match band data type ("
+         << "input: " << GDALGetDataTypeName(src_type) << ", target: " << GDALGetDataTypeName(type) << ")";
 
-    Nan::ThrowTypeError(ss.str().c_str());
-    return NULL;
+      Nan::ThrowTypeError(ss.str().c_str());
+      return NULL;
+    }
   }
   switch (type) {
-    case GDT_Byte: {
-      Nan::TypedArrayContents<GByte> contents(obj);
-      if (ValidateLength(contents.length(), min_length)) return NULL;
-      return *contents;
-    }
-    case GDT_Int16: {
-      Nan::TypedArrayContents<GInt16> contents(obj);
-      if (ValidateLength(contents.length(), min_length)) return NULL;
-      return *contents;
-    }
-    case GDT_UInt16: {
-      Nan::TypedArrayContents<GUInt16> contents(obj);
-      if (ValidateLength(contents.length(), min_length)) return NULL;
-      return *contents;
-    }
-    case GDT_Int32: {
-      Nan::TypedArrayContents<GInt32> contents(obj);
-      if (ValidateLength(contents.length(), min_length)) return NULL;
-      return *contents;
-    }
-    case GDT_UInt32: {
-      Nan::TypedArrayContents<GUInt32> contents(obj);
-      if (ValidateLength(contents.length(), min_length)) return NULL;
-      return *contents;
-    }
-    case GDT_Float32: {
-      Nan::TypedArrayContents<float> contents(obj);
-      if (ValidateLength(contents.length(), min_length)) return NULL;
-      return *contents;
-    }
-    case GDT_Float64: {
-      Nan::TypedArrayContents<double> contents(obj);
-      if (ValidateLength(contents.length(), min_length)) return NULL;
-      return *contents;
-    }
+    case GDT_Byte:
+    case GDT_Int16:
+    case GDT_UInt16:
+    case GDT_Int32:
+    case GDT_UInt32:
+    case GDT_Float32:
+    case GDT_Float64: break;
     default: Nan::ThrowError("Unsupported array type"); return NULL;
   }
+
+  // a byte view over the whole (Shared)ArrayBuffer
+  Local<Value> view = obj;
+  if (obj->IsArrayBuffer()) {
+    Local<ArrayBuffer> buffer = obj.As<ArrayBuffer>();
+    view = v8::Uint8Array::New(buffer, 0, buffer->ByteLength());
+  } else if (obj->IsSharedArrayBuffer()) {
+    Local<SharedArrayBuffer> buffer = obj.As<SharedArrayBuffer>();
+    view = v8::Uint8Array::New(buffer, 0, buffer->ByteLength());
+  }
+
+  Nan::TypedArrayContents<GByte> contents(view);
+  if (ValidateLength(contents.length() / (GDALGetDataTypeSize(type) / 8), min_length)) return NULL;
+  return *contents;
 }
 bool TypedArray::ValidateLength(int length, int min_length) {
   if (length < min_length) {
@@ -46,7 +46,11 @@ namespace node_gdal {
 namespace TypedArray {
 
 Local<Value> New(GDALDataType type, unsigned int length);
+Local<Value> New(GDALDataType type, Local<ArrayBuffer> buffer);
 GDALDataType Identify(Local<Object> array);
+// DataView, ArrayBuffer and SharedArrayBuffer have no element type,
+// they can hold data of any GDAL type
+bool IsRawMemory(Local<Object> obj);
 void *Validate(Local<Object> obj, GDALDataType type, int min_length);
 bool ValidateLength(int length, int min_length);
 } // namespace TypedArray
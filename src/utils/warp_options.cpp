@@ -12,6 +12,7 @@ WarpOptions::WarpOptions()
     dst_bands("dst band ids"),
     src_nodata(NULL),
     dst_nodata(NULL),
+    warp_options(NULL),
     multi(false) {
   options = GDALCreateWarpOptions();
 }
@@ -23,6 +24,7 @@ WarpOptions::~WarpOptions() {
   if (options) delete options;
   if (src_nodata) delete src_nodata;
   if (dst_nodata) delete dst_nodata;
+  if (warp_options) CSLDestroy(warp_options);
 }
 
 int WarpOptions::parseResamplingAlg(Local<Value> value) {
@@ -89,6 +91,7 @@ int WarpOptions::parseResamplingAlg(Local<Value> value) {
  *   dstNoData: double
  *   cutline: geometry
  *   blend: double
+ *   threads: int | "ALL_CPUS"
  * }
  */
 int WarpOptions::parse(Local<Value> value) {
@@ -253,6 +256,27 @@ int WarpOptions::parse(Local<Value> value) {
     prop = Nan::Get(obj, Nan::New("multi").ToLocalChecked()).ToLocalChecked();
     if (prop->IsTrue()) { multi = true; }
   }
+  if (Nan::HasOwnProperty(obj, Nan::New("threads").ToLocalChecked()).FromMaybe(false)) {
+    prop = Nan::Get(obj, Nan::New("threads").ToLocalChecked()).ToLocalChecked();
+    std::string threads;
+    if (prop->IsNumber()) {
+      int n = Nan::To<int32_t>(prop).ToChecked();
+      if (n < 1) {
+        Nan::ThrowRangeError("threads must be greater than 0");
+        return 1;
+      }
+      threads = std::to_string(n);
+    } else if (prop->IsString() && std::string(*Nan::Utf8String(prop)) == "ALL_CPUS") {
+      threads = "ALL_CPUS";
+    } else if (!prop->IsUndefined() && !prop->IsNull()) {
+      Nan::ThrowTypeError("threads property must be an integer or \"ALL_CPUS\"");
+      return 1;
+    }
+    if (!threads.empty()) {
+      warp_options = CSLSetNameValue(CSLDuplicate(additional_options.get()), "NUM_THREADS", threads.c_str());
+      options->papszWarpOptions = warp_options;
+    }
+  }
   return 0;
 }
 
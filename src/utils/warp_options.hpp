@@ -38,6 +38,7 @@ namespace node_gdal {
 //   dstNoData: double
 //   cutline: geometry
 //   blend: double
+//   threads: int | "ALL_CPUS"
 // }
 
 class WarpOptions {
@@ -62,6 +63,8 @@ class WarpOptions {
   IntegerList dst_bands;
   double *src_nodata;
   double *dst_nodata;
+  // additional options + NUM_THREADS, only when threads is set
+  char **warp_options;
   bool multi;
 };
 
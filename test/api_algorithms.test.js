@@ -1,5 +1,9 @@
 const gdal = require('../lib/gdal.js')
-const assert = require('chai').assert
+const chai = require('chai')
+const chaiAsPromised = require('chai-as-promised')
+const assert = chai.assert
+
+chai.use(chaiAsPromised)
 
 describe('gdal', () => {
   afterEach(gc)
@@ -59,6 +63,24 @@ describe('gdal', () => {
         assert.isFalse(feature.getGeometry().isEmpty())
       })
     })
+    it('should generate contours asynchronously', async () => {
+      const offset = 7
+      const interval = 32
+
+      await gdal.contourGenerateAsync({
+        src: srcband,
+        dst: lyr,
+        offset: offset,
+        interval: interval,
+        idField: 0,
+        elevField: 1
+      })
+
+      assert(lyr.features.count() > 0, 'features were created')
+      lyr.features.forEach((feature) => {
+        assert((feature.fields.get('elev') - offset) % interval === 0)
+      })
+    })
     it.skip('should accept an array of fixed levels', () => {
       const levels = [ 53, 43, 193 ].sort()
 
@@ -129,6 +151,32 @@ describe('gdal', () => {
         assert.notEqual(srcband.pixels.get(holes_x[i], holes_y[i]), nodata)
       }
     })
+    it('should fill nodata values asynchronously', (done) => {
+      gdal.fillNodataAsync({
+        src: srcband,
+        searchDist: 3,
+        smoothingIterations: 2
+      }, (err) => {
+        assert.isUndefined(err)
+        for (let i = 0; i < holes_x.length; i++) {
+          assert.notEqual(srcband.pixels.get(holes_x[i], holes_y[i]), nodata)
+        }
+        done()
+      })
+    })
+    it('should report progress', async () => {
+      let calls = 0
+      await gdal.fillNodataAsync({
+        src: srcband,
+        searchDist: 3,
+        progress_cb: (complete) => {
+          assert.isAtLeast(complete, 0)
+          assert.isAtMost(complete, 1)
+          calls++
+        }
+      })
+      assert.isAbove(calls, 0)
+    })
   })
   describe('checksumImage()', () => {
     let src, band
@@ -160,6 +208,26 @@ describe('gdal', () => {
       assert.notEqual(a, b)
       assert.notEqual(b, c)
     })
+    it('should generate the same checksum asynchronously', async () => {
+      for (let x = 0; x < w; x++) {
+        for (let y = 0; y < h; y++) {
+          band.pixels.set(x, y, (x * h + y) % 255)
+        }
+      }
+      assert.equal(await gdal.checksumImageAsync(band), gdal.checksumImage(band))
+      assert.equal(await gdal.checksumImageAsync(band, 8, 0, w / 2, h), gdal.checksumImage(band, 8, 0, w / 2, h))
+    })
+    it('should accept a callback', (done) => {
+      const expected = gdal.checksumImage(band)
+      gdal.checksumImageAsync(band, (err, checksum) => {
+        assert.isUndefined(err)
+        assert.equal(checksum, expected)
+        done()
+      })
+    })
+    it('should reject on an invalid region', () => {
+      return assert.isRejected(gdal.checksumImageAsync(band, w, 0), /offset invalid/)
+    })
   })
   describe('sieveFilter()', () => {
     let src, band
@@ -195,6 +263,19 @@ describe('gdal', () => {
         connectedness: 8
       })
 
+      assert.equal(band.pixels.get(8, 8), 20)
+    })
+    it('should filter in place asynchronously', async () => {
+      assert.equal(band.pixels.get(8, 8), 10)
+
+      // src and dst share the same dataset lock
+      await gdal.sieveFilterAsync({
+        src: band,
+        dst: band,
+        threshold: 4 * 4 + 1,
+        connectedness: 8
+      })
+
       assert.equal(band.pixels.get(8, 8), 20)
     })
   })
@@ -247,5 +328,36 @@ describe('gdal', () => {
         assert.instanceOf(geom, gdal.Polygon)
       })
     })
+    it('should generate polygons asynchronously', async () => {
+      await gdal.polygonizeAsync({
+        src: srcband,
+        dst: lyr,
+        pixValField: 0,
+        connectedness: 8
+      })
+
+      assert.equal(lyr.features.count(), 2)
+    })
+    it('should not deadlock when jobs share datasets', () => {
+      const dst2 = gdal.open('temp', 'w', 'Memory')
+      const lyr2 = dst2.layers.create('temp', null, gdal.Polygon)
+      lyr2.fields.add(new gdal.FieldDefn('val', gdal.OFTInteger))
+      return Promise.all([
+        gdal.polygonizeAsync({ src: srcband, dst: lyr, pixValField: 0 }),
+        gdal.polygonizeAsync({ src: srcband, dst: lyr2, pixValField: 0, useFloats: true }),
+        gdal.checksumImageAsync(srcband)
+      ]).then(() => {
+        assert.equal(lyr.features.count(), 2)
+        assert.equal(lyr2.features.count(), 2)
+        dst2.close()
+      })
+    })
+    it('should reject when aborted', () => {
+      if (typeof AbortController === 'undefined') return
+      const controller = new AbortController()
+      controller.abort()
+      return gdal.polygonizeAsync({ src: srcband, dst: lyr, pixValField: 0, signal: controller.signal })
+        .then(() => assert.fail('should have been aborted'), (err) => assert.match(err.message, /aborted/))
+    })
   })
 })
@@ -1,6 +1,7 @@
 const gdal = require('../lib/gdal.js')
 const assert = require('chai').assert
 const path = require('path')
+const { gatedFile, waitFor } = require('./utils/gate.js')
 
 if (process.env.GDAL_DATA !== undefined) {
   throw new Error(
@@ -101,4 +102,57 @@ describe('gdal', () => {
       assert.equal(gdal.decToDMS(14.12511, 'long', 1), " 14d 7'30.4\"E")
     })
   })
+  describe('setThreadPoolSize()', () => {
+    after(() => gdal.setThreadPoolSize(4))
+    it('should throw when size is less than 1', () => {
+      assert.throws(() => {
+        gdal.setThreadPoolSize(0)
+      }, /at least 1/)
+    })
+    it('should be reflected in getThreadPoolStats()', () => {
+      gdal.setThreadPoolSize(2)
+      assert.equal(gdal.getThreadPoolStats().size, 2)
+    })
+  })
+  describe('getThreadPoolStats()', () => {
+    it('should return the pool state', () => {
+      const stats = gdal.getThreadPoolStats()
+      assert.isNumber(stats.size)
+      assert.isNumber(stats.busy)
+      assert.isNumber(stats.queued)
+    })
+    describe('with jobs running', () => {
+      // /vsijs/ is not supported on GDAL 1.x
+      if (parseFloat(gdal.version) < 2) return
+      after(() => gdal.setThreadPoolSize(4))
+      it('should count the busy threads and run the queued jobs after a resize', async () => {
+        const gate = gatedFile(`${__dirname}/data/sample.tif`)
+        gdal.setThreadPoolSize(2)
+        try {
+          const ds = await gdal.openAsync(gate.path, 'r', { pool: 3 })
+          const band = ds.bands.get(1)
+          gate.hold()
+          const reads = [ 100, 300, 600 ].map((y) => band.pixels.readAsync(0, y, 16, 16))
+          // each held read blocks one thread
+          await waitFor(() => gate.waiting() === 2)
+          let stats = gdal.getThreadPoolStats()
+          assert.equal(stats.busy, 2)
+          assert.equal(stats.queued, 1)
+
+          gdal.setThreadPoolSize(3)
+          await waitFor(() => gate.waiting() === 3)
+          stats = gdal.getThreadPoolStats()
+          assert.equal(stats.busy, 3)
+          assert.equal(stats.queued, 0)
+
+          gate.release()
+          const results = await Promise.all(reads)
+          results.forEach((data) => assert.equal(data.length, 16 * 16))
+        } finally {
+          gate.release()
+          gate.unregister()
+        }
+      })
+    })
+  })
 })
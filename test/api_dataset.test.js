@@ -1,7 +1,11 @@
 const fs = require('fs')
 const gdal = require('../lib/gdal.js')
 const path = require('path')
-const assert = require('chai').assert
+const chai = require('chai')
+const chaiAsPromised = require('chai-as-promised')
+const assert = chai.assert
+
+chai.use(chaiAsPromised)
 const fileUtils = require('./utils/file.js')
 
 const NAD83_WKT =
@@ -307,6 +311,97 @@ describe('gdal.Dataset', () => {
         })
       })
     })
+    describe('"pixels" property', () => {
+      const create = () => {
+        const ds = gdal.open('temp', 'w', 'MEM', 4, 2, 3, gdal.GDT_Byte)
+        ds.bands.forEach((band, i) => {
+          band.pixels.write(0, 0, 4, 2, new Uint8Array(8).fill(i + 1))
+        })
+        return ds
+      }
+      it('should exist', () => {
+        assert.instanceOf(ds.pixels, gdal.DatasetPixels)
+      })
+      describe('read()', () => {
+        it('should read all bands band-sequential by default', () => {
+          const data = create().pixels.read(0, 0, 4, 2)
+          assert.instanceOf(data, Uint8Array)
+          assert.deepEqual(Array.from(data), [ 1, 1, 1, 1, 1, 1, 1, 1, 2, 2, 2, 2, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 3, 3 ])
+        })
+        it('should read pixel-interleaved bands in the given order', () => {
+          const data = create().pixels.read(0, 0, 2, 1, null, {
+            bands: [ 3, 1 ],
+            pixel_space: 2,
+            band_space: 1
+          })
+          assert.deepEqual(Array.from(data), [ 3, 1, 3, 1 ])
+        })
+        it('should convert to the type of the array', () => {
+          const data = create().pixels.read(0, 0, 1, 1, new Float64Array(3))
+          assert.deepEqual(Array.from(data), [ 1, 2, 3 ])
+        })
+        it('should downsample with the given resampling', () => {
+          const ds = create()
+          ds.bands.get(2).pixels.write(0, 0, 2, 1, new Uint8Array([ 0, 4 ]))
+          const data = ds.pixels.read(0, 0, 2, 1, null, {
+            bands: [ 2 ],
+            buffer_width: 1,
+            buffer_height: 1,
+            resampling: 'average'
+          })
+          assert.deepEqual(Array.from(data), [ 2 ])
+        })
+        it('should throw if the array is too small', () => {
+          assert.throws(() => {
+            create().pixels.read(0, 0, 4, 2, new Uint8Array(23))
+          }, /Array length must be greater than or equal to 24/)
+        })
+        it('should throw on an invalid band', () => {
+          assert.throws(() => {
+            create().pixels.read(0, 0, 4, 2, null, { bands: [ 4 ] })
+          }, /invalid band id/)
+        })
+        it('should throw if dataset is closed', () => {
+          const ds = create()
+          ds.close()
+          assert.throws(() => {
+            ds.pixels.read(0, 0, 4, 2)
+          }, /already been destroyed/)
+        })
+      })
+      describe('write()', () => {
+        it('should write pixel-interleaved bands', () => {
+          const ds = create()
+          ds.pixels.write(0, 0, 2, 1, new Uint8Array([ 10, 20, 30, 11, 21, 31 ]), {
+            pixel_space: 3,
+            band_space: 1
+          })
+          assert.deepEqual(Array.from(ds.bands.get(1).pixels.read(0, 0, 2, 1)), [ 10, 11 ])
+          assert.deepEqual(Array.from(ds.bands.get(2).pixels.read(0, 0, 2, 1)), [ 20, 21 ])
+          assert.deepEqual(Array.from(ds.bands.get(3).pixels.read(0, 0, 2, 1)), [ 30, 31 ])
+        })
+      })
+      describe('readAsync()', () => {
+        it('should resolve to the data', async () => {
+          const data = await create().pixels.readAsync(0, 0, 1, 1, null, { bands: [ 2, 3 ] })
+          assert.deepEqual(Array.from(data), [ 2, 3 ])
+        })
+        it('should accept a callback', (done) => {
+          create().pixels.readAsync(0, 0, 1, 1, (e, data) => {
+            assert.isUndefined(e)
+            assert.deepEqual(Array.from(data), [ 1, 2, 3 ])
+            done()
+          })
+        })
+      })
+      describe('writeAsync()', () => {
+        it('should write the data', async () => {
+          const ds = create()
+          await ds.pixels.writeAsync(3, 1, 1, 1, new Uint8Array([ 7, 8, 9 ]))
+          assert.deepEqual(Array.from(ds.pixels.read(3, 1, 1, 1)), [ 7, 8, 9 ])
+        })
+      })
+    })
     describe('"srs" property', () => {
       describe('getter', () => {
         it('should return SpatialReference', () => {
@@ -551,6 +646,51 @@ describe('gdal.Dataset', () => {
         })
       })
     })
+    describe('executeSQLAsync()', () => {
+      it('should resolve to a Layer', async () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const result_set = await ds.executeSQLAsync('SELECT name FROM sample')
+
+        assert.instanceOf(result_set, gdal.Layer)
+        assert.deepEqual(result_set.fields.getNames(), [ 'name' ])
+      })
+      it('should accept a callback and a dialect', (done) => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        ds.executeSQLAsync('SELECT COUNT(*) AS n FROM sample', null, 'SQLITE', (err, result_set) => {
+          assert.isUndefined(err)
+          assert.equal(result_set.features.first().fields.get('n'), ds.layers.get(0).features.count())
+          done()
+        })
+      })
+      it('should return a result set readable with the async iterator', async () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const result_set = await ds.executeSQLAsync('SELECT name FROM sample')
+        let count = 0
+        const iterator = result_set.features[Symbol.asyncIterator]()
+        while (!(await iterator.next()).done) count++
+        assert.equal(count, ds.layers.get(0).features.count())
+      })
+      it('should destroy result set when dataset is closed', async () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        const result_set = await ds.executeSQLAsync('SELECT name FROM sample')
+        ds.close()
+        assert.throws(() => {
+          result_set.fields.getNames()
+        })
+      })
+      it('should reject on an invalid statement', () => {
+        const ds = gdal.open(`${__dirname}/data/shp/sample.shp`)
+        return ds.executeSQLAsync('SELECT FROM WHERE').then(
+          () => assert.fail('should have been rejected'),
+          (err) => assert.instanceOf(err, Error)
+        )
+      })
+      it('should reject if dataset already closed', () => {
+        const ds = gdal.open(`${__dirname}/data/sample.vrt`)
+        ds.close()
+        return assert.isRejected(ds.executeSQLAsync('SELECT name FROM sample'), /already been destroyed/)
+      })
+    })
     describe('getFileList()', () => {
       it('should return list of filenames', () => {
         const ds = gdal.open(path.join(__dirname, 'data', 'sample.vrt'))
@@ -668,6 +808,72 @@ describe('gdal.Dataset', () => {
         })
       })
     })
+    describe('buildOverviewsAsync()', () => {
+      it('should generate overviews for all bands', async () => {
+        const ds = gdal.open(
+          fileUtils.clone(`${__dirname}/data/multiband.tif`),
+          'r+'
+        )
+        await ds.buildOverviewsAsync('NEAREST', [ 2, 4, 8 ])
+        ds.bands.forEach((band) => {
+          assert.equal(band.overviews.count(), 3)
+        })
+        ds.close()
+      })
+      it('should produce the same overviews with several threads', async () => {
+        const expected = gdal.open(
+          fileUtils.clone(`${__dirname}/data/multiband.tif`),
+          'r+'
+        )
+        expected.buildOverviews('AVERAGE', [ 2, 4 ])
+        const ds = gdal.open(
+          fileUtils.clone(`${__dirname}/data/multiband.tif`),
+          'r+'
+        )
+        await ds.buildOverviewsAsync('AVERAGE', [ 2, 4 ], undefined, { threads: 'ALL_CPUS' })
+        ds.bands.forEach((band) => {
+          assert.equal(
+            gdal.checksumImage(band.overviews.get(1)),
+            gdal.checksumImage(expected.bands.get(band.id).overviews.get(1))
+          )
+        })
+      })
+      it('should report progress and accept a callback', (done) => {
+        const ds = gdal.open(
+          fileUtils.clone(`${__dirname}/data/sample.tif`),
+          'r+'
+        )
+        const progress = []
+        ds.buildOverviewsAsync('NEAREST', [ 2 ], undefined, {
+          progress_cb: (complete) => progress.push(complete)
+        }, (err) => {
+          assert.isUndefined(err)
+          assert.isAbove(progress.length, 0)
+          assert.equal(ds.bands.get(1).overviews.count(), 1)
+          done()
+        })
+      })
+      it('should reject if threads is invalid', () => {
+        const ds = gdal.open(
+          fileUtils.clone(`${__dirname}/data/sample.tif`),
+          'r+'
+        )
+        return assert.isRejected(
+          ds.buildOverviewsAsync('NEAREST', [ 2 ], undefined, { threads: -1 }),
+          /threads/
+        )
+      })
+      it('should reject if invalid band given', () => {
+        const ds = gdal.open(
+          fileUtils.clone(`${__dirname}/data/sample.tif`),
+          'r+'
+        )
+        return assert.isRejected(
+          ds.buildOverviewsAsync('NEAREST', [ 2, 4, 8 ], [ 4 ]),
+          /invalid band/
+        )
+      })
+    })
   })
   describe('setGCPs()', () => {
     it('should update gcps', () => {
@@ -1,6 +1,10 @@
-const assert = require('chai').assert
+const chaiAsPromised = require('chai-as-promised')
+const chai = require('chai')
+const assert = chai.assert
 const gdal = require('../lib/gdal.js')
 
+chai.use(chaiAsPromised)
+
 describe('gdal.drivers', () => {
   afterEach(gc)
 
@@ -159,5 +163,86 @@ describe('gdal.drivers', () => {
         process.exit(1)
       })
     })
+    it('should report progress', async () => {
+      if (gdal.version.split('.')[0] < 2) {
+        return
+      }
+      const driver = gdal.drivers.get('GTiff')
+      const progress = []
+      const ds = await driver.createCopyAsync(
+        `/vsimem/progress_${String(Math.random()).substring(2)}.tif`,
+        gdal.open(`${__dirname}/data/12_791_1476.jpg`),
+        [],
+        { progress_cb: (complete) => progress.push(complete) }
+      )
+      assert.instanceOf(ds, gdal.Dataset)
+      assert.isAbove(progress.length, 0)
+      progress.forEach((complete) => assert.isAtMost(complete, 1))
+    })
+    it('should reject when aborted', () => {
+      if (gdal.version.split('.')[0] < 2 || typeof AbortController === 'undefined') {
+        return
+      }
+      const driver = gdal.drivers.get('GTiff')
+      const controller = new AbortController()
+      controller.abort()
+      return assert.isRejected(driver.createCopyAsync(
+        `/vsimem/aborted_${String(Math.random()).substring(2)}.tif`,
+        gdal.open(`${__dirname}/data/12_791_1476.jpg`),
+        [],
+        { signal: controller.signal }
+      ), /aborted/)
+    })
+  })
+
+  describe('createCopyToBuffer()', () => {
+    if (gdal.version.split('.')[0] < 2) return
+    it('should return the file content', () => {
+      const buffer = gdal.drivers.get('PNG').createCopyToBuffer(gdal.open(`${__dirname}/data/12_791_1476.jpg`))
+      assert.instanceOf(buffer, Buffer)
+      assert.deepEqual(Array.from(buffer.subarray(1, 4)), Array.from(Buffer.from('PNG')))
+      const ds = gdal.open(buffer)
+      assert.equal(ds.driver.description, 'PNG')
+      assert.equal(ds.rasterSize.x, 256)
+    })
+    it('should pass the creation options', () => {
+      const src = gdal.open(`${__dirname}/data/12_791_1476.jpg`)
+      const driver = gdal.drivers.get('GTiff')
+      const raw = driver.createCopyToBuffer(src)
+      const compressed = driver.createCopyToBuffer(src, { COMPRESS: 'DEFLATE' })
+      assert.isBelow(compressed.length, raw.length)
+    })
+    it('should throw if the source is not a Dataset', () => {
+      assert.throws(() => {
+        gdal.drivers.get('GTiff').createCopyToBuffer(null)
+      }, /must be an instance of Dataset/)
+    })
+  })
+
+  describe('createCopyToBufferAsync()', () => {
+    if (gdal.version.split('.')[0] < 2) return
+    it('should resolve to the file content', async () => {
+      const buffer = await gdal.drivers.get('GTiff').createCopyToBufferAsync(
+        gdal.open(`${__dirname}/data/12_791_1476.jpg`))
+      assert.instanceOf(buffer, Buffer)
+      assert.equal(gdal.open(buffer).bands.count(), 3)
+    })
+    it('should accept a callback', (done) => {
+      gdal.drivers.get('GTiff').createCopyToBufferAsync(gdal.open(`${__dirname}/data/12_791_1476.jpg`), (e, buffer) => {
+        assert.isUndefined(e)
+        assert.instanceOf(buffer, Buffer)
+        done()
+      })
+    })
+    it('should reject when aborted', () => {
+      if (typeof AbortController === 'undefined') return
+      const controller = new AbortController()
+      controller.abort()
+      return assert.isRejected(gdal.drivers.get('GTiff').createCopyToBufferAsync(
+        gdal.open(`${__dirname}/data/12_791_1476.jpg`),
+        [],
+        { signal: controller.signal }
+      ), /aborted/)
+    })
   })
 })
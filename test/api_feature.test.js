@@ -246,6 +246,53 @@ describe('gdal.Feature', () => {
           assert.equal(obj.name, 'test')
           assert.closeTo(obj.value, 3.14, 0.0001)
         })
+        it('should follow changes of the layer fields', () => {
+          const ds = gdal.open('', 'w', 'Memory')
+          const lyr = ds.layers.create('', null, gdal.Point)
+          lyr.fields.add(new gdal.FieldDefn('a', gdal.OFTInteger))
+          assert.deepEqual(Object.keys(new gdal.Feature(lyr).fields.toObject()), [ 'a' ])
+          lyr.fields.add(new gdal.FieldDefn('b', gdal.OFTString))
+          assert.deepEqual(Object.keys(new gdal.Feature(lyr).fields.toObject()), [ 'a', 'b' ])
+          lyr.fields.remove('a')
+          const feature = new gdal.Feature(lyr)
+          feature.fields.set({ b: 'value' })
+          assert.deepEqual(feature.fields.toObject(), { b: 'value' })
+        })
+        it('should not call the setters of Object.prototype', () => {
+          const feature = new gdal.Feature(defn)
+          feature.fields.set([ 5, 'test', 3.14 ])
+          let called = false
+          Object.defineProperty(Object.prototype, 'name', {
+            set: () => {
+              called = true
+            },
+            configurable: true
+          })
+          try {
+            assert.equal(feature.fields.toObject().name, 'test')
+          } finally {
+            delete Object.prototype.name
+          }
+          assert.isFalse(called)
+        })
+      })
+      describe('toGeoJSON()', () => {
+        it('should return a GeoJSON Feature', () => {
+          const feature = new gdal.Feature(defn)
+          feature.fields.set([ 5, 'test', 3.14 ])
+          feature.setGeometry(new gdal.Point(1, 2))
+          feature.fid = 7
+          assert.deepEqual(feature.toGeoJSON(), {
+            type: 'Feature',
+            id: 7,
+            properties: { id: 5, name: 'test', value: 3.14 },
+            geometry: { type: 'Point', coordinates: [ 1, 2 ] }
+          })
+        })
+        it('should return a null geometry', () => {
+          const feature = new gdal.Feature(defn)
+          assert.isNull(feature.toGeoJSON().geometry)
+        })
       })
       describe('toJSON()', () => {
         it('should return the fields as a stringified JSON object', () => {
@@ -34,6 +34,21 @@ describe('gdal.Geometry', () => {
         coordinates: [ 1, 2, 3 ]
       })
     })
+    it('should match toJSON() for all geometry types', () => {
+      [
+        'LINESTRING (0 0,1 1,2 0)',
+        'POLYGON ((0 0,10 0,10 10,0 10,0 0),(1 1,2 1,2 2,1 1))',
+        'MULTIPOINT (1 2,3 4)',
+        'MULTILINESTRING ((0 0,1 1),(2 2,3 3))',
+        'MULTIPOLYGON (((0 0,1 0,1 1,0 0)),((2 2,3 2,3 3,2 2)))',
+        'GEOMETRYCOLLECTION (POINT (1 2),LINESTRING (0 0,1 1))',
+        'LINESTRING (0 0 1,1 1 2)',
+        'POLYGON EMPTY'
+      ].forEach((wkt) => {
+        const geom = gdal.Geometry.fromWKT(wkt)
+        assert.deepEqual(geom.toObject(), JSON.parse(geom.toJSON()), wkt)
+      })
+    })
   })
   describe('toKML()', () => {
     it('should return valid result', () => {
@@ -101,16 +116,64 @@ describe('gdal.Geometry', () => {
       assert.equal(point2d.y, 2)
     })
   })
-  if (parseFloat(gdal.version) >= 2.3) {
-    describe('fromGeoJson()', () => {
-      it('should return valid result', () => {
-        const point2d = gdal.Geometry.fromGeoJson({ type: 'Point', coordinates: [ 2, 1 ] })
-        assert.equal(point2d.wkbType, gdal.wkbPoint)
-        assert.equal(point2d.x, 2)
-        assert.equal(point2d.y, 1)
+  describe('fromGeoJson()', () => {
+    it('should return valid result', () => {
+      const point2d = gdal.Geometry.fromGeoJson({ type: 'Point', coordinates: [ 2, 1 ] })
+      assert.equal(point2d.wkbType, gdal.wkbPoint)
+      assert.equal(point2d.x, 2)
+      assert.equal(point2d.y, 1)
+    })
+    it('should round-trip with toObject()', () => {
+      [
+        { type: 'Point', coordinates: [ 1, 2, 3 ] },
+        { type: 'LineString', coordinates: [ [ 0, 0 ], [ 1, 1 ] ] },
+        { type: 'Polygon', coordinates: [ [ [ 0, 0 ], [ 1, 0 ], [ 1, 1 ], [ 0, 0 ] ] ] },
+        { type: 'MultiPoint', coordinates: [ [ 1, 2 ], [ 3, 4 ] ] },
+        { type: 'MultiLineString', coordinates: [ [ [ 0, 0 ], [ 1, 1 ] ] ] },
+        { type: 'MultiPolygon', coordinates: [ [ [ [ 0, 0 ], [ 1, 0 ], [ 1, 1 ], [ 0, 0 ] ] ] ] },
+        { type: 'GeometryCollection', geometries: [ { type: 'Point', coordinates: [ 1, 2 ] } ] }
+      ].forEach((geojson) => {
+        assert.deepEqual(gdal.Geometry.fromGeoJson(geojson).toObject(), geojson)
       })
     })
-  }
+    it('should accept Float64Array coordinates', () => {
+      const line = gdal.Geometry.fromGeoJson({ type: 'LineString', coordinates: new Float64Array([ 0, 1, 2, 3 ]) })
+      assert.equal(line.toWKT(), 'LINESTRING (0 1,2 3)')
+      const point = gdal.Geometry.fromGeoJson({ type: 'Point', coordinates: new Float64Array([ 4, 5 ]) })
+      assert.equal(point.toWKT(), 'POINT (4 5)')
+    })
+    it('should throw on invalid GeoJSON', () => {
+      assert.throws(() => {
+        gdal.Geometry.fromGeoJson({ type: 'Point', coordinates: [ 'a', 1 ] })
+      }, /Invalid GeoJSON/)
+      assert.throws(() => {
+        gdal.Geometry.fromGeoJson({ type: 'Circle', coordinates: [] })
+      }, /Invalid GeoJSON/)
+    })
+  })
+  describe('children.toTypedArray()', () => {
+    it('should return coordinates, curve offsets and parts', () => {
+      const multi = gdal.Geometry.fromWKT('MULTIPOLYGON (((0 0,1 0,1 1,0 0)),((2 2,3 2,3 3,2 2),(2.1 2.1,2.2 2.1,2.2 2.2,2.1 2.1)))')
+      const { coordinates, offsets, parts } = multi.children.toTypedArray()
+      assert.lengthOf(coordinates, 24)
+      assert.deepEqual(Array.from(offsets), [ 0, 4, 8, 12 ])
+      assert.deepEqual(Array.from(parts), [ 0, 1, 3 ])
+    })
+  })
+  describe('children.setFromTypedArray()', () => {
+    it('should round-trip with toTypedArray()', () => {
+      const wkt = 'MULTIPOLYGON (((0 0,1 0,1 1,0 0)),((2 2,3 2,3 3,2 2),(2 2,2 3,3 3,2 2)))'
+      const { coordinates, offsets, parts } = gdal.Geometry.fromWKT(wkt).children.toTypedArray()
+      const multi = new gdal.MultiPolygon()
+      multi.children.setFromTypedArray(coordinates, offsets, parts)
+      assert.equal(multi.toWKT(), wkt)
+    })
+    it('should create one child per curve without parts', () => {
+      const multi = new gdal.MultiLineString()
+      multi.children.setFromTypedArray(new Float64Array([ 0, 0, 1, 1, 2, 2, 3, 3 ]), new Int32Array([ 0, 2, 4 ]))
+      assert.equal(multi.toWKT(), 'MULTILINESTRING ((0 0,1 1),(2 2,3 3))')
+    })
+  })
   describe('getConstructor()', () => {
     //  wkbUnknown = 0, wkbPoint = 1, wkbLineString = 2, wkbPolygon = 3,
     //  wkbMultiPoint = 4, wkbMultiLineString = 5, wkbMultiPolygon = 6, wkbGeometryCollection = 7,
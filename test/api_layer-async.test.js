@@ -0,0 +1,178 @@
+const chaiAsPromised = require('chai-as-promised')
+const chai = require('chai')
+const assert = chai.assert
+const gdal = require('../lib/gdal.js')
+const fileUtils = require('./utils/file.js')
+
+chai.use(chaiAsPromised)
+const expect = chai.expect
+
+// Not supported on GDAL 1.x
+if (parseFloat(gdal.version) < 2) return
+
+describe('gdal.LayerAsync', () => {
+  afterEach(gc)
+
+  const open_layer = () => {
+    const dir = fileUtils.cloneDir(`${__dirname}/data/shp`)
+    const ds = gdal.open(`${dir}/sample.shp`)
+    return { ds, layer: ds.layers.get(0) }
+  }
+
+  describe('"features" property', () => {
+    describe('countAsync()', () => {
+      it('should resolve to an integer', () => {
+        const { layer } = open_layer()
+        return assert.eventually.equal(layer.features.countAsync(), 23)
+      })
+      it('should accept a callback', (done) => {
+        const { layer } = open_layer()
+        layer.features.countAsync((e, count) => {
+          assert.isUndefined(e)
+          assert.equal(count, 23)
+          done()
+        })
+      })
+      it('should throw error if dataset is destroyed', () => {
+        const { ds, layer } = open_layer()
+        ds.close()
+        return assert.isRejected(layer.features.countAsync(), /already destroyed/)
+      })
+    })
+    describe('getAsync()', () => {
+      it('should resolve to a Feature', async () => {
+        const { layer } = open_layer()
+        const feature = await layer.features.getAsync(0)
+        assert.instanceOf(feature, gdal.Feature)
+      })
+      it("should resolve to null if index doesn't exist", () => {
+        const { layer } = open_layer()
+        return assert.eventually.isNull(layer.features.getAsync(99))
+      })
+    })
+    describe('nextAsync()', () => {
+      it('should resolve to a Feature and increment the iterator', async () => {
+        const { layer } = open_layer()
+        const f1 = await layer.features.nextAsync()
+        const f2 = await layer.features.nextAsync()
+        assert.instanceOf(f1, gdal.Feature)
+        assert.instanceOf(f2, gdal.Feature)
+        assert.notEqual(f1.fid, f2.fid)
+      })
+      it('should resolve to null after last feature', async () => {
+        const { layer } = open_layer()
+        const count = await layer.features.countAsync()
+        for (let i = 0; i < count; i++) {
+          await layer.features.nextAsync()
+        }
+        assert.isNull(await layer.features.nextAsync())
+      })
+    })
+    describe('readBatchAsync()', () => {
+      it('should resolve to an array of Features', async () => {
+        const { layer } = open_layer()
+        const batch = await layer.features.readBatchAsync(10)
+        assert.lengthOf(batch, 10)
+        batch.forEach((f) => assert.instanceOf(f, gdal.Feature))
+      })
+      it('should read all features in batches', async () => {
+        const { layer } = open_layer()
+        let batch, total = 0
+        while ((batch = await layer.features.readBatchAsync(10)).length) {
+          total += batch.length
+        }
+        assert.equal(total, 23)
+      })
+      it('should accept a callback', (done) => {
+        const { layer } = open_layer()
+        layer.features.readBatchAsync(3, (e, batch) => {
+          assert.isUndefined(e)
+          assert.lengthOf(batch, 3)
+          done()
+        })
+      })
+    })
+    describe('readColumnsAsync()', () => {
+      it('should resolve to the columns of all features', async () => {
+        const { layer } = open_layer()
+        const columns = await layer.readColumnsAsync({ fields: [ 'name' ] })
+        assert.equal(columns.count, 23)
+        assert.instanceOf(columns.fields.name.data, Uint8Array)
+        assert.instanceOf(columns.geometry.wkb, Uint8Array)
+      })
+      it('should accept a callback', (done) => {
+        const { layer } = open_layer()
+        layer.readColumnsAsync({ batchSize: 5, geometry: 'none' }, (e, columns) => {
+          assert.isUndefined(e)
+          assert.equal(columns.count, 5)
+          assert.isUndefined(columns.geometry)
+          done()
+        })
+      })
+    })
+    describe('toGeoJSONStringAsync()', () => {
+      it('should resolve to a FeatureCollection', async () => {
+        const { layer } = open_layer()
+        const collection = JSON.parse(await layer.toGeoJSONStringAsync({ precision: 3 }))
+        assert.equal(collection.type, 'FeatureCollection')
+        assert.lengthOf(collection.features, 23)
+      })
+    })
+    describe('firstAsync()', () => {
+      it('should resolve to a Feature and reset the iterator', async () => {
+        const { layer } = open_layer()
+        await layer.features.nextAsync()
+        const f = await layer.features.firstAsync()
+        assert.instanceOf(f, gdal.Feature)
+        assert.equal(f.fid, 0)
+      })
+      it('should accept a callback', (done) => {
+        const { layer } = open_layer()
+        layer.features.firstAsync((e, f) => {
+          assert.isUndefined(e)
+          assert.equal(f.fid, 0)
+          done()
+        })
+      })
+    })
+    describe('[Symbol.asyncIterator]()', () => {
+      it('should iterate through all features', async () => {
+        const { layer } = open_layer()
+        const iterator = layer.features[Symbol.asyncIterator]()
+        const fids = []
+        let r
+        while (!(r = await iterator.next()).done) {
+          assert.instanceOf(r.value, gdal.Feature)
+          fids.push(r.value.fid)
+        }
+        assert.lengthOf(fids, 23)
+        assert.deepEqual(fids, fids.map((v, i) => i))
+      })
+      it('should reset the feature pointer', async () => {
+        const { layer } = open_layer()
+        layer.features.next()
+        const r = await layer.features[Symbol.asyncIterator]().next()
+        assert.equal(r.value.fid, 0)
+      })
+      it('should stop when return() is called', async () => {
+        const { layer } = open_layer()
+        const iterator = layer.features[Symbol.asyncIterator]()
+        await iterator.next()
+        await iterator.return()
+        assert.isTrue((await iterator.next()).done)
+      })
+      it('should reject once and stop if a read fails', async () => {
+        const { ds, layer } = open_layer()
+        ds.close()
+        const iterator = layer.features[Symbol.asyncIterator]()
+        await assert.isRejected(iterator.next(), /already destroyed/)
+        assert.isTrue((await iterator.next()).done)
+      })
+    })
+    it('should not be affected by the dataset being garbage collected', () => {
+      const p = open_layer().layer.features.firstAsync()
+      gc()
+      return expect(p).to.eventually.be.instanceOf(gdal.Feature)
+    })
+  })
+})
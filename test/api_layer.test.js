@@ -368,6 +368,128 @@ describe('gdal.Layer', () => {
       })
     })
 
+    describe('readColumns()', () => {
+      it('should return one column per field', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          const columns = layer.readColumns()
+          assert.equal(columns.count, 23)
+          assert.instanceOf(columns.fid, Float64Array)
+          assert.lengthOf(columns.fid, 23)
+          assert.deepEqual(Object.keys(columns.fields), layer.fields.getNames())
+        })
+      })
+      it('should return string columns as offsets and UTF-8 bytes', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          const { fields } = layer.readColumns({ fields: [ 'name' ], geometry: 'none' })
+          const name = fields.name
+          assert.equal(name.type, 'string')
+          assert.instanceOf(name.offsets, Int32Array)
+          assert.instanceOf(name.data, Uint8Array)
+          assert.lengthOf(name.offsets, 24)
+          const feature = layer.features.get(0)
+          const value = Buffer.from(name.data.subarray(name.offsets[0], name.offsets[1])).toString()
+          assert.equal(value, feature.fields.get('name'))
+          assert.equal(name.valid[0] & 1, 1)
+        })
+      })
+      it('should return the geometries as WKB', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          const { geometry } = layer.readColumns({ fields: [] })
+          assert.instanceOf(geometry.wkb, Uint8Array)
+          assert.lengthOf(geometry.offsets, 24)
+          assert.equal(geometry.offsets[23], geometry.wkb.length)
+          const wkb = Buffer.from(geometry.wkb.subarray(geometry.offsets[0], geometry.offsets[1]))
+          assert.isTrue(gdal.Geometry.fromWKB(wkb).equals(layer.features.get(0).getGeometry()))
+        })
+      })
+      it('should return the geometries as coordinates', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          const { geometry } = layer.readColumns({ fields: [], geometry: 'xy' })
+          assert.instanceOf(geometry.xy, Float64Array)
+          assert.equal(geometry.xy.length, 2 * geometry.offsets[23])
+        })
+      })
+      it('should read in batches', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          let columns, total = 0
+          while ((columns = layer.readColumns({ batchSize: 10 })).count) {
+            assert.isAtMost(columns.count, 10)
+            total += columns.count
+          }
+          assert.equal(total, 23)
+        })
+      })
+      it('should throw error on unknown field', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          assert.throws(() => {
+            layer.readColumns({ fields: [ 'not_a_field' ] })
+          }, /does not exist/)
+        })
+      })
+      it('should throw error if dataset is destroyed', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          dataset.close()
+          assert.throws(() => {
+            layer.readColumns()
+          }, /already been destroyed/)
+        })
+      })
+    })
+
+    describe('toGeoJSONString()', () => {
+      it('should return a FeatureCollection', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          const collection = JSON.parse(layer.toGeoJSONString())
+          assert.equal(collection.type, 'FeatureCollection')
+          assert.lengthOf(collection.features, 23)
+          const feature = layer.features.get(0)
+          assert.equal(collection.features[0].properties.name, feature.fields.get('name'))
+          assert.equal(collection.features[0].id, feature.fid)
+          assert.equal(collection.features[0].geometry.type, feature.toGeoJSON().geometry.type)
+        })
+      })
+      it('should round the coordinates to the precision', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          const collection = JSON.parse(layer.toGeoJSONString({ precision: 2 }))
+          const coords = collection.features[0].geometry.coordinates.flat(Infinity)
+          coords.forEach((c) => assert.closeTo(c, Math.round(c * 100) / 100, 1e-9))
+        })
+      })
+      it('should not lose any digits by default', () => {
+        const ds = gdal.open('temp', 'w', 'Memory')
+        const layer = ds.layers.create('temp', null, gdal.Point)
+        layer.fields.add(new gdal.FieldDefn('value', gdal.OFTReal))
+        const feature = new gdal.Feature(layer)
+        feature.fields.set('value', 0.1 + 0.2)
+        feature.setGeometry(new gdal.Point(1 / 3, 0.1))
+        layer.features.add(feature)
+        const json = layer.toGeoJSONString()
+        const collection = JSON.parse(json)
+        assert.strictEqual(collection.features[0].properties.value, 0.1 + 0.2)
+        assert.deepEqual(collection.features[0].geometry.coordinates, [ 1 / 3, 0.1 ])
+        // the shortest representation is used
+        assert.notInclude(json, '0.10000000000000001')
+        ds.close()
+      })
+      it('should write the bounding boxes', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          const collection = JSON.parse(layer.toGeoJSONString({ bbox: true }))
+          const extent = layer.getExtent()
+          assert.lengthOf(collection.features[0].bbox, 4)
+          assert.closeTo(collection.bbox[0], extent.minX, 1e-9)
+          assert.closeTo(collection.bbox[3], extent.maxY, 1e-9)
+        })
+      })
+      it('should throw error if dataset is destroyed', () => {
+        prepare_dataset_layer_test('r', (dataset, layer) => {
+          dataset.close()
+          assert.throws(() => {
+            layer.toGeoJSONString()
+          }, /already been destroyed/)
+        })
+      })
+    })
+
     describe('"features" property', () => {
       describe('getter', () => {
         it('should return LayerFeatures', () => {
@@ -450,6 +572,39 @@ describe('gdal.Layer', () => {
           })
         })
       })
+      describe('readBatch()', () => {
+        it('should return an array of Features and advance the iterator', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const batch = layer.features.readBatch(5)
+            assert.isArray(batch)
+            assert.lengthOf(batch, 5)
+            batch.forEach((f) => assert.instanceOf(f, gdal.Feature))
+            assert.equal(layer.features.next().fid, batch[4].fid + 1)
+          })
+        })
+        it('should return a short array then an empty array at the end', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            const count = layer.features.count()
+            assert.lengthOf(layer.features.readBatch(count + 10), count)
+            assert.lengthOf(layer.features.readBatch(10), 0)
+          })
+        })
+        it('should throw error if count is not positive', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            assert.throws(() => {
+              layer.features.readBatch(0)
+            }, /positive/)
+          })
+        })
+        it('should throw error if dataset is destroyed', () => {
+          prepare_dataset_layer_test('r', (dataset, layer) => {
+            dataset.close()
+            assert.throws(() => {
+              layer.features.readBatch(10)
+            }, /already destroyed/)
+          })
+        })
+      })
       describe('first()', () => {
         it('should return a Feature and reset the iterator', () => {
           prepare_dataset_layer_test('r', (dataset, layer) => {
@@ -191,6 +191,33 @@ describe('gdal.LineString', () => {
           assert.equal(line.points.count(), 2)
         })
       })
+      describe('toTypedArray()', () => {
+        it('should return interleaved coordinates', () => {
+          const line = new gdal.LineString()
+          line.points.add(1, 2, 3)
+          line.points.add(4, 5, 6)
+          const xyz = line.points.toTypedArray()
+          assert.instanceOf(xyz, Float64Array)
+          assert.deepEqual(Array.from(xyz), [ 1, 2, 3, 4, 5, 6 ])
+          assert.deepEqual(Array.from(line.points.toTypedArray({ dims: 2 })), [ 1, 2, 4, 5 ])
+        })
+      })
+      describe('setFromTypedArray()', () => {
+        it('should replace the points', () => {
+          const line = new gdal.LineString()
+          line.points.add(9, 9)
+          line.points.setFromTypedArray(new Float64Array([ 0, 1, 2, 3, 4, 5 ]))
+          assert.equal(line.toWKT(), 'LINESTRING (0 1,2 3,4 5)')
+          line.points.setFromTypedArray(new Float64Array([ 0, 1, 2, 3, 4, 5 ]), 3)
+          assert.equal(line.toWKT(), 'LINESTRING (0 1 2,3 4 5)')
+        })
+        it('should throw on invalid length', () => {
+          const line = new gdal.LineString()
+          assert.throws(() => {
+            line.points.setFromTypedArray(new Float64Array([ 0, 1, 2 ]))
+          }, /multiple/)
+        })
+      })
       describe('reverse()', () => {
         it('should flip order of points', () => {
           const line = new gdal.LineString()
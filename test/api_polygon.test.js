@@ -183,6 +183,31 @@ describe('gdal.Polygon', () => {
         })
       })
     })
+    describe('rings.toTypedArray()', () => {
+      it('should return coordinates and ring offsets', () => {
+        const polygon = gdal.Geometry.fromWKT('POLYGON ((0 0,10 0,10 10,0 0),(1 1,2 1,2 2,1 1))')
+        const { coordinates, offsets } = polygon.rings.toTypedArray()
+        assert.instanceOf(coordinates, Float64Array)
+        assert.deepEqual(Array.from(offsets), [ 0, 4, 8 ])
+        assert.deepEqual(Array.from(coordinates.subarray(8, 10)), [ 1, 1 ])
+      })
+    })
+    describe('rings.setFromTypedArray()', () => {
+      it('should replace the rings', () => {
+        const polygon = new gdal.Polygon()
+        polygon.rings.setFromTypedArray(
+          new Float64Array([ 0, 0, 10, 0, 10, 10, 0, 0, 1, 1, 2, 1, 2, 2, 1, 1 ]),
+          new Int32Array([ 0, 4, 8 ])
+        )
+        assert.equal(polygon.toWKT(), 'POLYGON ((0 0,10 0,10 10,0 0),(1 1,2 1,2 2,1 1))')
+      })
+      it('should throw on invalid offsets', () => {
+        const polygon = new gdal.Polygon()
+        assert.throws(() => {
+          polygon.rings.setFromTypedArray(new Float64Array([ 0, 0, 1, 1 ]), new Int32Array([ 0, 3 ]))
+        }, /offsets/)
+      })
+    })
     describe('getArea()', () => {
       it('should return area', () => {
         const polygon = new gdal.Polygon()
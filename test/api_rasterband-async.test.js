@@ -2,6 +2,7 @@ const chaiAsPromised = require('chai-as-promised')
 const chai = require('chai')
 const assert = chai.assert
 const gdal = require('../lib/gdal.js')
+const { gatedFile, waitFor } = require('./utils/gate.js')
 
 chai.use(chaiAsPromised)
 const expect = chai.expect
@@ -298,6 +299,122 @@ describe('gdal.RasterBand', () => {
           })
         })
       })
+      describe('readAsync() w/progress', () => {
+        it('should call progress_cb', async () => {
+          const ds = await gdal.openAsync(`${__dirname}/data/sample.tif`)
+          const band = ds.bands.get(1)
+          const progress = []
+          const data = await band.pixels.readAsync(0, 0, ds.rasterSize.x, ds.rasterSize.y, undefined, {
+            progress_cb: (complete) => progress.push(complete)
+          })
+          assert.equal(data.length, ds.rasterSize.x * ds.rasterSize.y)
+          assert.isAbove(progress.length, 0)
+        })
+        it('should reject when aborted', async () => {
+          if (typeof AbortController === 'undefined') return
+          const ds = await gdal.openAsync(`${__dirname}/data/sample.tif`)
+          const band = ds.bands.get(1)
+          const controller = new AbortController()
+          controller.abort()
+          await expect(band.pixels.readAsync(0, 0, 16, 16, undefined, { signal: controller.signal }))
+            .to.be.rejectedWith(/aborted/)
+        })
+      })
+      describe('computeStatisticsAsync()', () => {
+        const create = () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+          const data = new Uint8Array(16 * 16)
+          for (let i = 0; i < data.length; i++) data[i] = i % 10
+          ds.bands.get(1).pixels.write(0, 0, 16, 16, data)
+          return ds
+        }
+        it('should resolve to the same statistics as computeStatistics()', async () => {
+          const band = create().bands.get(1)
+          const expected = band.computeStatistics(false)
+          const stats = await band.computeStatisticsAsync(false)
+          assert.deepEqual(stats, expected)
+          assert.equal(stats.min, 0)
+          assert.equal(stats.max, 9)
+        })
+        it('should call progress_cb', async () => {
+          const band = create().bands.get(1)
+          const progress = []
+          await band.computeStatisticsAsync(false, { progress_cb: (complete) => progress.push(complete) })
+          assert.isAbove(progress.length, 0)
+        })
+        it('should accept a callback', (done) => {
+          const band = create().bands.get(1)
+          band.computeStatisticsAsync(false, (err, stats) => {
+            assert.isUndefined(err)
+            assert.equal(stats.max, 9)
+            done()
+          })
+        })
+      })
+      describe('getStatisticsAsync()', () => {
+        it('should resolve to the statistics', async () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+          const band = ds.bands.get(1)
+          band.fill(5)
+          const stats = await band.getStatisticsAsync(false, true)
+          assert.equal(stats.min, 5)
+          assert.equal(stats.max, 5)
+          assert.equal(stats.std_dev, 0)
+        })
+        it('should reject if statistics cannot be computed without scanning', () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+          return expect(ds.bands.get(1).getStatisticsAsync(false, false)).to.be.rejectedWith(/without scanning/)
+        })
+      })
+      describe('readAsync() on a pooled dataset', () => {
+        it('should return the same data as a normal dataset', async () => {
+          const ds = await gdal.openAsync(`${__dirname}/data/sample.tif`, 'r', { pool: 4 })
+          const band = ds.bands.get(1)
+          const reads = []
+          for (let i = 0; i < 16; i++) reads.push(band.pixels.readAsync(190, 290 + i, 20, 30))
+          const results = await Promise.all(reads)
+          const expected = gdal.open(`${__dirname}/data/sample.tif`).bands.get(1).pixels.read(190, 290, 20, 30)
+          assert.deepEqual(results[0], expected)
+          results.forEach((data) => assert.equal(data.length, 20 * 30))
+        })
+        it('should be supported by gdal.open()', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`, 'r', { pool: 2 })
+          return assert.eventually.instanceOf(ds.bands.get(1).pixels.readAsync(0, 0, 16, 16), Uint8Array)
+        })
+        it('should throw on a dataset opened for writing', () => {
+          assert.throws(() => {
+            gdal.open(`${__dirname}/data/sample.tif`, 'r+', { pool: 2 })
+          }, /can be pooled/)
+        })
+        it('should reject if dataset already closed', async () => {
+          const ds = await gdal.openAsync(`${__dirname}/data/sample.tif`, 'r', { pool: 2 })
+          const band = ds.bands.get(1)
+          ds.close()
+          await expect(band.pixels.readAsync(0, 0, 16, 16)).to.be.rejectedWith(Error)
+        })
+        it('should reject a queued read if the dataset is closed', async () => {
+          const gate = gatedFile(`${__dirname}/data/sample.tif`)
+          gdal.setThreadPoolSize(1)
+          try {
+            const blocker = await gdal.openAsync(gate.path)
+            const ds = await gdal.openAsync(`${__dirname}/data/sample.tif`, 'r', { pool: 2 })
+            // keep the only pool thread busy so that the pooled read stays queued
+            gate.hold()
+            const blocked = blocker.bands.get(1).pixels.readAsync(0, 400, 16, 16)
+            await waitFor(() => gate.waiting() > 0)
+            const read = assert.isRejected(ds.bands.get(1).pixels.readAsync(0, 0, 16, 16), /already been destroyed/)
+            assert.equal(gdal.getThreadPoolStats().queued, 1)
+            ds.close()
+            gate.release()
+            await blocked
+            await read
+          } finally {
+            gate.release()
+            gate.unregister()
+            gdal.setThreadPoolSize(4)
+          }
+        })
+      })
     })
   })
 })
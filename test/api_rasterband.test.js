@@ -495,6 +495,63 @@ describe('gdal.RasterBand', () => {
           assert.equal(data.length, w * h)
           assert.equal(data[10 * 20 + 10], 10)
         })
+        it('should return a plain TypedArray', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          const data = ds.bands.get(1).pixels.read(0, 0, 4, 4)
+          assert.deepEqual(Object.keys(data), Object.keys(new Uint8Array(16)))
+          assert.equal(data.byteOffset, 0)
+          assert.equal(data.buffer.byteLength, 16)
+        })
+        it('should return an array matching the requested data type', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          const data = ds.bands.get(1).pixels.read(0, 0, 4, 4, undefined, { type: gdal.GDT_Float64 })
+          assert.instanceOf(data, Float64Array)
+          assert.equal(data.length, 16)
+        })
+        describe('w/resampling option', () => {
+          const create = () => {
+            const ds = gdal.open('temp', 'w', 'MEM', 4, 4, 1, gdal.GDT_Float32)
+            const band = ds.bands.get(1)
+            band.pixels.write(0, 0, 4, 4, new Float32Array([ 0, 2, 4, 6, 2, 4, 6, 8, 8, 8, 0, 0, 8, 8, 0, 0 ]))
+            return band
+          }
+          it('should use nearest neighbour by default', () => {
+            const data = create().pixels.read(0, 0, 4, 4, undefined, { buffer_width: 2, buffer_height: 2 })
+            assert.deepEqual(Array.from(data), [ 4, 8, 8, 0 ])
+          })
+          it('should downsample with the given algorithm', () => {
+            const data = create().pixels.read(0, 0, 4, 4, undefined, {
+              buffer_width: 2,
+              buffer_height: 2,
+              resampling: 'average'
+            })
+            assert.deepEqual(Array.from(data), [ 2, 6, 8, 0 ])
+          })
+          it('should read a fractional window', () => {
+            // the whole pixels window would be [ 0, 2 ] and nearest would pick 2
+            const data = create().pixels.read(0.25, 0, 1, 1, undefined, { buffer_width: 1, buffer_height: 1 })
+            assert.deepEqual(Array.from(data), [ 0 ])
+          })
+          it('should throw on an invalid algorithm', () => {
+            assert.throws(() => {
+              create().pixels.read(0, 0, 4, 4, undefined, { resampling: 'foo' })
+            }, /Invalid resampling algorithm/)
+          })
+          it('should throw on a non-finite or out of range window', () => {
+            assert.throws(() => create().pixels.read(NaN, 0, 4, 4), RangeError)
+            assert.throws(() => create().pixels.read(0, 0, Infinity, 4), RangeError)
+            assert.throws(() => create().pixels.read(0, 0, 4, 1e10), RangeError)
+            assert.throws(() => create().pixels.read(-1e10, 0, 4, 4), RangeError)
+          })
+          it('should be supported by readAsync()', async () => {
+            const data = await create().pixels.readAsync(0, 0, 4, 4, undefined, {
+              buffer_width: 2,
+              buffer_height: 2,
+              resampling: 'average'
+            })
+            assert.deepEqual(Array.from(data), [ 2, 6, 8, 0 ])
+          })
+        })
         describe('w/data argument', () => {
           it('should put the data in the existing array', () => {
             const ds = gdal.open(
@@ -528,6 +585,44 @@ describe('gdal.RasterBand', () => {
             assert.instanceOf(data, Uint8Array)
             assert.equal(data.length, 20 * 30)
           })
+          it('should respect the byte offset of the array', () => {
+            const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+            const band = ds.bands.get(1)
+            band.fill(7)
+            const buffer = Buffer.alloc(64 + 16 * 16)
+            const data = buffer.subarray(64)
+            band.pixels.read(0, 0, 16, 16, data)
+            assert.equal(buffer[63], 0)
+            assert.equal(buffer[64], 7)
+            assert.equal(buffer[buffer.length - 1], 7)
+          })
+          it('should convert into a DataView with the given type', () => {
+            const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+            const band = ds.bands.get(1)
+            band.fill(42)
+            const view = new DataView(new ArrayBuffer(8 + 16 * 16 * 4), 8)
+            const result = band.pixels.read(0, 0, 16, 16, view, { type: gdal.GDT_Float32 })
+            assert.equal(result, view)
+            assert.equal(view.getFloat32(0, true), 42)
+            assert.equal(view.getFloat32(16 * 16 * 4 - 4, true), 42)
+          })
+          it('should accept a SharedArrayBuffer', () => {
+            const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+            const band = ds.bands.get(1)
+            band.fill(3)
+            const sab = new SharedArrayBuffer(16 * 16 * 2)
+            band.pixels.read(0, 0, 16, 16, sab, { type: gdal.GDT_Int16 })
+            assert.equal(new Int16Array(sab)[255], 3)
+            const shared_view = new Uint8Array(new SharedArrayBuffer(16 * 16))
+            band.pixels.read(0, 0, 16, 16, shared_view)
+            assert.equal(shared_view[100], 3)
+          })
+          it('should throw if a raw buffer is too small for the type', () => {
+            const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+            assert.throws(() => {
+              ds.bands.get(1).pixels.read(0, 0, 16, 16, new ArrayBuffer(16 * 16), { type: gdal.GDT_Float64 })
+            }, /Array length/)
+          })
           it('should throw error if array is too small', () => {
             const ds = gdal.open(
               'temp',
@@ -754,6 +849,28 @@ describe('gdal.RasterBand', () => {
             assert.equal(result[i], data[i])
           }
         })
+        it('should write data from a DataView with the given type', () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+          const band = ds.bands.get(1)
+          const view = new DataView(new ArrayBuffer(4 + 16 * 16 * 8), 4)
+          for (let i = 0; i < 16 * 16; i++) view.setFloat64(i * 8, i % 200, true)
+
+          band.pixels.write(0, 0, 16, 16, view, { type: gdal.GDT_Float64 })
+
+          const result = band.pixels.read(0, 0, 16, 16)
+          assert.equal(result[0], 0)
+          assert.equal(result[199], 199)
+          assert.equal(result[255], 55)
+        })
+        it('should write data from an ArrayBuffer in the band data type', () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Int16)
+          const band = ds.bands.get(1)
+          const data = new Int16Array(16 * 16).fill(-5)
+
+          band.pixels.write(0, 0, 16, 16, data.buffer)
+
+          assert.equal(band.pixels.get(15, 15), -5)
+        })
         it('should throw error if array is too small', () => {
           const ds = gdal.open('temp', 'w', 'MEM', 256, 256, 1, gdal.GDT_Byte)
           const band = ds.bands.get(1)
@@ -948,6 +1065,61 @@ describe('gdal.RasterBand', () => {
           })
         })
       })
+      describe('pinBlock()', () => {
+        // external ArrayBuffers need the BackingStore API
+        if (parseInt(process.versions.node) < 14) return
+        it('should return the same values as readBlock()', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          const band = ds.bands.get(1)
+          const data = band.pixels.pinBlock(0, 0)
+          assert.instanceOf(data, Uint8Array)
+          assert.deepEqual(data, band.pixels.readBlock(0, 0))
+          band.pixels.unpinBlock(data)
+        })
+        it('should reflect the writes made before pinning', () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Float32)
+          const band = ds.bands.get(1)
+          band.pixels.set(1, 0, 5)
+          const data = band.pixels.pinBlock(0, 0)
+          assert.equal(data[1], 5)
+          band.pixels.unpinBlock(data)
+        })
+        it('should throw error if offsets are out of range', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          assert.throws(() => {
+            ds.bands.get(1).pixels.pinBlock(-1, 0)
+          })
+        })
+        it('should be emptied by unpinBlock()', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          const band = ds.bands.get(1)
+          const data = band.pixels.pinBlock(0, 0)
+          band.pixels.unpinBlock(data)
+          assert.equal(data.length, 0)
+          assert.throws(() => {
+            band.pixels.unpinBlock(data)
+          }, /not a pinned block/)
+        })
+        it('should be emptied when the dataset is closed', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          const data = ds.bands.get(1).pixels.pinBlock(0, 0)
+          ds.close()
+          assert.equal(data.length, 0)
+        })
+        it('should keep the dataset alive', () => {
+          const data = gdal.open(`${__dirname}/data/sample.tif`).bands.get(1).pixels.pinBlock(0, 0)
+          gc()
+          assert.isAbove(data.length, 0)
+        })
+      })
+      describe('unpinBlock()', () => {
+        it('should throw if the array is not a pinned block', () => {
+          const ds = gdal.open(`${__dirname}/data/sample.tif`)
+          assert.throws(() => {
+            ds.bands.get(1).pixels.unpinBlock(new Uint8Array(4))
+          }, /not a pinned block/)
+        })
+      })
       describe('writeBlock()', () => {
         it('should write data from TypedArray', () => {
           let i
@@ -1144,5 +1316,42 @@ describe('gdal.RasterBand', () => {
         })
       })
     })
+    describe('mapVirtualMemory()', () => {
+      if (process.platform !== 'linux') {
+        it('should throw outside of Linux', () => {
+          const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+          assert.throws(() => ds.bands.get(1).mapVirtualMemory(), /only supported on Linux/)
+        })
+        return
+      }
+      // external ArrayBuffers need the BackingStore API
+      if (parseInt(process.versions.node) < 14) return
+      it('should map the pixels of the band', () => {
+        const ds = gdal.open('temp', 'w', 'MEM', 64, 32, 1, gdal.GDT_Int16)
+        const band = ds.bands.get(1)
+        const data = new Int16Array(64 * 32)
+        for (let i = 0; i < data.length; i++) data[i] = i - 1000
+        band.pixels.write(0, 0, 64, 32, data)
+        const map = band.mapVirtualMemory()
+        assert.instanceOf(map.buffer, ArrayBuffer)
+        assert.equal(map.pixelSpace, 2)
+        assert.equal(map.lineSpace, 128)
+        const view = new DataView(map.buffer)
+        const little = new Uint8Array(new Uint16Array([ 1 ]).buffer)[0] === 1
+        assert.equal(view.getInt16(5 * map.lineSpace + 7 * map.pixelSpace, little), 5 * 64 + 7 - 1000)
+        assert.equal(view.getInt16(31 * map.lineSpace + 63 * map.pixelSpace, little), 32 * 64 - 1 - 1000)
+      })
+      it('should be detached when the dataset is closed', () => {
+        const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+        const map = ds.bands.get(1).mapVirtualMemory()
+        assert.isAbove(map.buffer.byteLength, 0)
+        ds.close()
+        assert.equal(map.buffer.byteLength, 0)
+      })
+      it('should throw on an invalid mode', () => {
+        const ds = gdal.open('temp', 'w', 'MEM', 16, 16, 1, gdal.GDT_Byte)
+        assert.throws(() => ds.bands.get(1).mapVirtualMemory({ mode: 'x' }), /mode/)
+      })
+    })
   })
 })
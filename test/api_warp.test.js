@@ -1,5 +1,9 @@
 const gdal = require('../lib/gdal.js')
-const assert = require('chai').assert
+const chai = require('chai')
+const chaiAsPromised = require('chai-as-promised')
+const assert = chai.assert
+
+chai.use(chaiAsPromised)
 
 describe('gdal', () => {
   afterEach(gc)
@@ -294,6 +298,65 @@ describe('gdal', () => {
 
       assert.equal(result_checksum, expected_checksum)
     })
+    describe('reprojectImageAsync()', () => {
+      const prepare = () => {
+        const options = {
+          src: src,
+          s_srs: src.srs,
+          t_srs: gdal.SpatialReference.fromEPSG(4326)
+        }
+        const info = gdal.suggestedWarpOutput(options)
+        info.rasterSize.x /= 4
+        info.rasterSize.y /= 4
+        info.geoTransform[1] *= 4
+        info.geoTransform[5] *= 4
+        options.dst = gdal.open('temp', 'w', 'MEM', info.rasterSize.x, info.rasterSize.y, 1, gdal.GDT_Byte)
+        options.dst.geoTransform = info.geoTransform
+        return options
+      }
+      it('should produce the same result as reprojectImage()', async () => {
+        const options = prepare()
+        gdal.reprojectImage(options)
+        const expected_checksum = gdal.checksumImage(options.dst.bands.get(1))
+
+        const async_options = prepare()
+        await gdal.reprojectImageAsync(async_options)
+        assert.equal(gdal.checksumImage(async_options.dst.bands.get(1)), expected_checksum)
+      })
+      it('should produce the same result with multiple threads', async () => {
+        const options = prepare()
+        gdal.reprojectImage(options)
+        const expected_checksum = gdal.checksumImage(options.dst.bands.get(1))
+
+        const async_options = prepare()
+        async_options.multi = true
+        async_options.threads = 4
+        await gdal.reprojectImageAsync(async_options)
+        assert.equal(gdal.checksumImage(async_options.dst.bands.get(1)), expected_checksum)
+      })
+      it('should accept a callback', (done) => {
+        const options = prepare()
+        options.threads = 'ALL_CPUS'
+        gdal.reprojectImageAsync(options, (err) => {
+          assert.isUndefined(err)
+          done()
+        })
+      })
+      it('should report progress', async () => {
+        const options = prepare()
+        const progress = []
+        options.progress_cb = (complete) => progress.push(complete)
+        await gdal.reprojectImageAsync(options)
+        assert.isAbove(progress.length, 0)
+      })
+      it('should reject if threads is invalid', async () => {
+        const options = prepare()
+        options.threads = 0
+        await assert.isRejected(gdal.reprojectImageAsync(options), /threads/)
+        options.threads = 'all'
+        await assert.isRejected(gdal.reprojectImageAsync(options), /threads/)
+      })
+    })
     it('should throw if cutline is wrong geometry type', () => {
       const options = {
         src: src,
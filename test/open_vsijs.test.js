@@ -0,0 +1,121 @@
+const gdal = require('../lib/gdal.js')
+const path = require('path')
+const fs = require('fs')
+const chai = require('chai')
+const chaiAsPromised = require('chai-as-promised')
+const assert = chai.assert
+const { gatedFile, waitFor } = require('./utils/gate.js')
+chai.use(chaiAsPromised)
+
+describe('Open', () => {
+  afterEach(gc)
+
+  describe('vsijs', () => {
+    // Not supported on GDAL 1.x
+    if (parseFloat(gdal.version) < 2) return
+
+    const filename = path.join(__dirname, 'data/sample.tif')
+    const data = fs.readFileSync(filename)
+    let name, reads
+
+    const reader = (offset, length) => {
+      reads.push([ offset, length ])
+      return new Promise((resolve) => setImmediate(() => resolve(data.slice(offset, offset + length))))
+    }
+
+    beforeEach(() => {
+      name = `sample_${String(Math.random()).substring(2)}.tif`
+      reads = []
+    })
+    afterEach(() => {
+      gdal.vsijs.unregister(name)
+    })
+
+    it('should read the same data as the file', () => {
+      const file = gdal.vsijs.register(name, data.length, reader)
+      assert.equal(file, `/vsijs/${name}`)
+      const expected = gdal.open(filename).bands.get(1).pixels.read(0, 0, 64, 64)
+      return assert.isFulfilled(gdal.openAsync(file)
+        .then((ds) => ds.bands.get(1).pixels.readAsync(0, 0, 64, 64))
+        .then((pixels) => {
+          assert.deepEqual(pixels, expected)
+          assert.isAbove(reads.length, 0)
+        }))
+    })
+    it('should serve the repeated reads from the cache', () => {
+      const file = gdal.vsijs.register(name, data.length, reader, { blockSize: 4096 })
+      let ds
+      return assert.isFulfilled(gdal.openAsync(file)
+        .then((r) => {
+          ds = r
+          return ds.bands.get(1).pixels.readAsync(0, 0, 16, 16)
+        })
+        .then(() => {
+          const count = reads.length
+          ds.bands.get(1).flush()
+          return ds.bands.get(1).pixels.readAsync(0, 0, 16, 16).then(() => assert.equal(reads.length, count))
+        }))
+    })
+    it('should read each range once with the cache disabled', async () => {
+      gdal.vsijs.setCacheSize(0)
+      try {
+        const file = gdal.vsijs.register(name, data.length, reader, { blockSize: 1024, readAhead: 0 })
+        const ds = await gdal.openAsync(file)
+        reads = []
+        // 8 strips of 7872 bytes
+        const pixels = await ds.bands.get(1).pixels.readAsync(0, 0, 984, 64)
+        assert.deepEqual(pixels, gdal.open(filename).bands.get(1).pixels.read(0, 0, 984, 64))
+        assert.isAtMost(reads.length, 8)
+      } finally {
+        gdal.vsijs.setCacheSize(16 * 1024 * 1024)
+      }
+    })
+    it('should read ahead on sequential reads', () => {
+      const file = gdal.vsijs.register(name, data.length, reader, { blockSize: 1024, readAhead: 3 })
+      return assert.isFulfilled(gdal.openAsync(file).then(() => {
+        assert.isAtLeast(reads[0][1], Math.min(4 * 1024, data.length))
+        for (const [ offset ] of reads) assert.equal(offset % 1024, 0)
+      }))
+    })
+    it('should accept a synchronous reader', () => {
+      const file = gdal.vsijs.register(name, data.length, (offset, length) => data.slice(offset, offset + length))
+      return assert.eventually.equal(gdal.openAsync(file).then((ds) => ds.rasterSize.x), 984)
+    })
+    it('should reject when the reader fails', () => {
+      const file = gdal.vsijs.register(name, data.length, () => Promise.reject(new Error('network error')))
+      return assert.isRejected(gdal.openAsync(file))
+    })
+    it('should not call the reader from synchronous methods', () => {
+      const file = gdal.vsijs.register(name, data.length, reader)
+      assert.throws(() => gdal.open(file))
+      assert.lengthOf(reads, 0)
+    })
+    it('should not block close() while a read is pending', async () => {
+      const gate = gatedFile(filename)
+      try {
+        const ds = await gdal.openAsync(gate.path)
+        gate.hold()
+        const read = assert.isRejected(ds.bands.get(1).pixels.readAsync(0, 400, 16, 16))
+        await waitFor(() => gate.waiting() > 0)
+        ds.close()
+        await read
+      } finally {
+        gate.release()
+        gate.unregister()
+      }
+    })
+    it('should throw when registering an existing file', () => {
+      gdal.vsijs.register(name, data.length, reader)
+      assert.throws(() => gdal.vsijs.register(name, data.length, reader), /already exists/)
+    })
+    it('unregister() should remove the file', () => {
+      const file = gdal.vsijs.register(name, data.length, reader)
+      assert.isTrue(gdal.vsijs.unregister(name))
+      assert.isFalse(gdal.vsijs.unregister(name))
+      return assert.isRejected(gdal.openAsync(file))
+    })
+    it('setCacheSize() should throw on a negative size', () => {
+      assert.throws(() => gdal.vsijs.setCacheSize(-1), RangeError)
+    })
+  })
+})
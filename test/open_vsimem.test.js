@@ -81,4 +81,68 @@ describe('Open', () => {
       assert.isRejected(gdal.openAsync(buffer))
     })
   })
+  describe('gdal.vsimem.release()', () => {
+    it('should return the file content and remove the file', () => {
+      const filename = `/vsimem/release_${String(Math.random()).substring(2)}.tif`
+      const ds = gdal.open(filename, 'w', 'GTiff', 16, 16, 1, gdal.GDT_Byte)
+      ds.bands.get(1).pixels.write(0, 0, 16, 16, new Uint8Array(256).fill(7))
+      ds.close()
+      const buffer = gdal.vsimem.release(filename)
+      assert.instanceOf(buffer, Buffer)
+      assert.equal(gdal.open(buffer).bands.get(1).pixels.get(3, 3), 7)
+      assert.throws(() => gdal.vsimem.release(filename), /does not exist/)
+    })
+    it('should refuse a file backed by a Buffer', () => {
+      const buffer = fs.readFileSync(path.join(__dirname, 'data/park.geo.json'))
+      const ds = gdal.open(buffer)
+      assert.throws(() => gdal.vsimem.release(ds.description), /backed by a Buffer/)
+    })
+  })
+  describe('gdal.vsimem Buffer registry', () => {
+    const load = () => fs.readFileSync(path.join(__dirname, 'data/park.geo.json'))
+
+    afterEach(() => gdal.vsimem.setMaxBufferBytes(0))
+
+    it('should account for the opened Buffers', () => {
+      const buffer = load()
+      const before = gdal.vsimem.getBufferStats()
+      const ds = gdal.open(buffer)
+      const after = gdal.vsimem.getBufferStats()
+      assert.equal(after.count, before.count + 1)
+      assert.equal(after.bytes, before.bytes + buffer.length)
+      assert.equal(after.maxBytes, 0)
+      ds.close()
+    })
+    it('unlinkBuffer() should remove the file without breaking open datasets', () => {
+      const buffer = load()
+      const ds = gdal.open(buffer)
+      const before = gdal.vsimem.getBufferStats()
+      assert.isTrue(gdal.vsimem.unlinkBuffer(buffer))
+      assert.isFalse(gdal.vsimem.unlinkBuffer(buffer))
+      assert.equal(gdal.vsimem.getBufferStats().count, before.count - 1)
+      assert.throws(() => gdal.open(ds.description))
+      assert.equal(ds.layers.get(0).features.count(), 1)
+      ds.close()
+    })
+    it('setMaxBufferBytes() should evict the least recently used Buffers', () => {
+      const first = load()
+      const second = load()
+      const ds1 = gdal.open(first)
+      const ds2 = gdal.open(second)
+      gdal.vsimem.setMaxBufferBytes(first.length)
+      const stats = gdal.vsimem.getBufferStats()
+      assert.isAtMost(stats.bytes, first.length)
+      assert.equal(stats.maxBytes, first.length)
+      assert.throws(() => gdal.open(ds1.description))
+      const ds3 = gdal.open(ds2.description)
+      assert.equal(ds3.layers.count(), 1)
+      ds3.close()
+      assert.equal(ds1.layers.get(0).features.count(), 1)
+      ds1.close()
+      ds2.close()
+    })
+    it('setMaxBufferBytes() should throw on a negative size', () => {
+      assert.throws(() => gdal.vsimem.setMaxBufferBytes(-1), RangeError)
+    })
+  })
 })
@@ -0,0 +1,40 @@
+const fs = require('fs')
+const path = require('path')
+const gdal = require('../../lib/gdal.js')
+
+// Registers a /vsijs/ copy of a file whose reads can be held, the async jobs
+// reading it keep their pool thread busy until the reads are released
+module.exports.gatedFile = function (file) {
+  const data = fs.readFileSync(file)
+  const name = `gated_${String(Math.random()).substring(2)}${path.extname(file)}`
+  const held = []
+  let closed = false
+
+  const read = (offset, length) => {
+    const result = () => data.slice(offset, offset + length)
+    if (!closed) return result()
+    return new Promise((resolve) => held.push(() => resolve(result())))
+  }
+
+  return {
+    path: gdal.vsijs.register(name, data.length, read, { blockSize: 1024, readAhead: 0 }),
+    hold: () => {
+      closed = true
+    },
+    release: () => {
+      closed = false
+      held.splice(0).forEach((resolve) => resolve())
+    },
+    // number of reads currently held, each one blocks a pool thread
+    waiting: () => held.length,
+    unregister: () => gdal.vsijs.unregister(name)
+  }
+}
+
+// Resolves once cond() returns true
+module.exports.waitFor = function (cond) {
+  return new Promise((resolve) => {
+    const poll = () => (cond() ? resolve() : setTimeout(poll, 1))
+    poll()
+  })
+}